@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <scores.hpp>
+#include <bit_matrix.hpp>
+
+class BitMatrixFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::mt19937 generator(31);
+        std::bernoulli_distribution member(0.04);
+        sets.assign(200, base::dynamic_bitset<>(700));
+        for (auto &set : sets)
+            for (int I = 0; I < 700; I++)
+                if (member(generator))
+                    set[I] = true;
+    }
+
+    vb sets;
+};
+
+TEST_F(BitMatrixFixture, RowsAreAlignedCopiesOfTheSetsTest) {
+    BitMatrix matrix(sets);
+
+    ASSERT_EQ(matrix.getNumRows(), 200);
+    ASSERT_EQ(matrix.getNumColumns(), 700);
+    ASSERT_EQ(matrix.getStride() * sizeof(BitMatrix::block_type) % BitMatrix::ALIGNMENT, 0);
+    ASSERT_GE(matrix.getStride() * 32, 700);
+    for (auto I = 0u; I < sets.size(); I++) {
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(matrix.getRowBlocks(I)) % BitMatrix::ALIGNMENT, 0);
+        ASSERT_EQ(matrix.getBitset(I), sets[I]);
+        ASSERT_EQ(matrix.getRow(I).count(), sets[I].count());
+    }
+    ASSERT_EQ(matrix.heapBytes(), 200 * matrix.getStride() * sizeof(BitMatrix::block_type));
+}
+
+TEST_F(BitMatrixFixture, RowViewsModifyTheMatrixTest) {
+    BitMatrix matrix(3, 40);
+    matrix.getRow(1)[5] = true;
+    matrix.getRow(1)[39] = true;
+    BitMatrix copy = matrix;
+    copy.getRow(1)[5] = false;
+
+    ASSERT_TRUE(matrix.getRow(0).none());
+    ASSERT_EQ(matrix.getRow(1).find_first_set(), 5);
+    ASSERT_EQ(matrix.getRow(1).count(), 2);
+    ASSERT_EQ(copy.getRow(1).count(), 1);
+    ASSERT_TRUE(matrix.getRow(2).none());
+}
+
+TEST_F(BitMatrixFixture, MatrixScoresMatchBitsetScoresTest) {
+    BitMatrix matrix(sets);
+
+    ASSERT_EQ(getScores<JaccardScore>(matrix, 0, 700), getScores<JaccardScore>(sets, 0, 700));
+    ASSERT_EQ(getScores(matrix, ScoreType::overlap_size, 20, 35, 3), getScores(sets, ScoreType::overlap_size, 20, 35));
+    ASSERT_EQ(getScores<AllOverlapScores>(matrix, 0, 700), getScores<AllOverlapScores>(sets, 0, 700));
+}
+
+TEST(BitMatrixSuite, SetsOfDifferentSizesThrowTest) {
+    vb sets = {base::dynamic_bitset<>(4), base::dynamic_bitset<>(5)};
+
+    ASSERT_THROW(BitMatrix{sets}, std::invalid_argument);
+    ASSERT_EQ(BitMatrix(vb()).getNumRows(), 0);
+}
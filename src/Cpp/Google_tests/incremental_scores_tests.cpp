@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include <scores.hpp>
+#include <incremental_scores.hpp>
+
+class IncrementalScoresFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::mt19937 generator(43);
+        std::bernoulli_distribution member(0.05);
+        sets.assign(150, base::dynamic_bitset<>(400));
+        for (auto &set : sets)
+            for (int I = 0; I < 400; I++)
+                if (member(generator))
+                    set[I] = true;
+    }
+
+    vb sets;
+
+    std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> jaccard =
+            getJaccardSimilarity;
+};
+
+TEST_F(IncrementalScoresFixture, ContentHashesDetectChangedModulesTest) {
+    auto hashes = getContentHashes(sets);
+    vb updated = sets;
+    updated[3][0].flip();
+    updated[70][399].flip();
+    updated.push_back(sets[0]);
+
+    ASSERT_EQ(getContentHash(sets[5]), getContentHash(vb(sets)[5]));
+    ASSERT_EQ(getChangedModules(hashes, updated), (std::vector<int>{3, 70, 150}));
+    ASSERT_EQ(getChangedModules(sets, updated), (std::vector<int>{3, 70, 150}));
+    ASSERT_TRUE(getChangedModules(hashes, sets).empty());
+}
+
+TEST_F(IncrementalScoresFixture, UpdatedScoresMatchFullRunTest) {
+    auto scores = getScores(sets, jaccard, 10, 30);
+    auto hashes = getContentHashes(sets);
+
+    // Modules gain and lose members, move in and out of the size range, and are appended
+    std::mt19937 generator(47);
+    std::uniform_int_distribution<int> entity(0, 399);
+    for (int module : {2, 8, 9, 120})
+        for (int I = 0; I < 12; I++)
+            sets[module][entity(generator)].flip();
+    sets[40] = base::dynamic_bitset<>(400);
+    sets.push_back(sets[1]);
+    sets.push_back(sets[7]);
+
+    updateScores(scores, sets, getChangedModules(hashes, sets), jaccard, 10, 30, 3);
+
+    ASSERT_EQ(scores, getScores(sets, jaccard, 10, 30));
+}
+
+TEST_F(IncrementalScoresFixture, UpdatedScoresAfterRemovingModulesTest) {
+    auto scores = getScores(sets, ScoreType::overlap_size, 0, 400);
+    vb old_sets = sets;
+    sets.resize(100);
+    sets[10] = sets[11];
+    auto changed = getChangedModules(old_sets, sets);
+
+    ASSERT_EQ(changed.size(), 51u);
+    ASSERT_EQ(changed.front(), 10);
+    ASSERT_EQ(changed.back(), 149);
+    ASSERT_EQ(getChangedModules(getContentHashes(old_sets), sets), changed);
+    updateScores(scores, sets, changed, ScoreType::overlap_size, 0, 400);
+
+    ASSERT_EQ(scores, getScores(sets, ScoreType::overlap_size, 0, 400));
+}
@@ -1,10 +1,13 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <vector>
+#include <span>
 #include <Interactome.hpp>
 #include <tuple>
+#include <filesystem>
 
 using ::testing::UnorderedElementsAreArray;
+using ::testing::ElementsAre;
 using ::testing::Contains;
 using ::testing::AnyOf;
 using ::testing::Not;
@@ -59,7 +62,8 @@ TEST_F(InteractomeFixture, CreateNetworkFromInteractionList) {
 }
 
 TEST_F(InteractomeFixture, GetAllInteractorsTest) {
-    std::vector<int> neighbors = interactome.getInteractors(2);
+    auto interactors = interactome.getInteractors(2);
+    std::vector<int> neighbors(interactors.begin(), interactors.end());
 
     ASSERT_EQ(neighbors.size(), 2);
     ASSERT_THAT(neighbors, UnorderedElementsAreArray({1, 3}));
@@ -67,10 +71,53 @@ TEST_F(InteractomeFixture, GetAllInteractorsTest) {
 }
 
 TEST_F(InteractomeFixture, GetAllInteractorsWithNonexistentNodeTest) {
-    std::vector<int> neighbors;
+    std::span<const int> neighbors;
     ASSERT_THROW(neighbors = interactome.getInteractors(7), std::out_of_range);
 }
 
+TEST_F(InteractomeFixture, InteractorsAreSortedTest) {
+    std::vector<std::pair<int, int>> interactions = {
+            std::make_pair(2, 9),
+            std::make_pair(2, 0),
+            std::make_pair(6, 2)
+    };
+    interactome.addInteractions(interactions);
+
+    auto interactors = interactome.getInteractors(2);
+    ASSERT_THAT(std::vector<int>(interactors.begin(), interactors.end()), ElementsAre(0, 1, 3, 6, 9));
+}
+
+TEST_F(InteractomeFixture, RepeatedInteractionsAreStoredOnceTest) {
+    std::vector<std::pair<int, int>> interactions = {
+            std::make_pair(2, 1),
+            std::make_pair(1, 2),
+            std::make_pair(3, 3)
+    };
+    interactome.addInteractions(interactions);
+
+    ASSERT_EQ(interactome.getInteractors(1).size(), 1);
+    ASSERT_EQ(interactome.getInteractors(2).size(), 2);
+    ASSERT_EQ(interactome.getInteractors(3).size(), 1);
+    ASSERT_EQ(interactome.getNumInteractions(), 3);
+}
+
+TEST_F(InteractomeFixture, AddInteractionsKeepsNamesTest) {
+    std::vector<std::pair<int, int>> interactions = {std::make_pair(5, 1)};
+    interactome.addInteractions(interactions);
+
+    ASSERT_EQ(interactome.getNodeName(1), "A");
+    ASSERT_EQ(interactome.getNodeName(5), "E");
+    ASSERT_THAT(interactome.getNodes(), UnorderedElementsAreArray({1, 2, 3, 4, 5}));
+}
+
+TEST_F(InteractomeFixture, AddedNodeHasNoInteractorsTest) {
+    interactome.addNode(9);
+
+    ASSERT_TRUE(interactome.getInteractors(9).empty());
+    ASSERT_EQ(interactome.getNumVertices(), 10);
+    ASSERT_FALSE(interactome.hasNode(8));
+}
+
 TEST_F(InteractomeFixture, CheckIfNodeExistsByIndexTest) {
     ASSERT_TRUE(interactome.hasNode(1));
     ASSERT_FALSE(interactome.hasNode(7));
@@ -163,9 +210,440 @@ TEST_F(InteractomeFixture, CheckIfNodeExistsByNameTest) {
 }
 
 TEST_F(InteractomeFixture, ReadTypesTest){
-    std::string ranges = "";
+    std::string ranges = "0 1\n2 2\n3 4\n5 5\n";
     std::istringstream ss(ranges);
     interactome.readTypeRanges(ss);
 
-    ASSERT_EQ(interactome.getGenesStart(0));
-}
\ No newline at end of file
+    ASSERT_EQ(interactome.getStartIndex(genes), 0);
+    ASSERT_EQ(interactome.getEndIndex(genes), 1);
+    ASSERT_EQ(interactome.getStartIndex(proteoforms), 3);
+    ASSERT_EQ(interactome.getEndIndex(SimpleEntity), 5);
+}
+
+TEST_F(InteractomeFixture, ReadTypesWithMissingLevelThrowsExceptionTest){
+    std::string ranges = "0 1\n2 2\n3 5\n";
+    std::istringstream ss(ranges);
+    ASSERT_THROW(interactome.readTypeRanges(ss), std::invalid_argument);
+}
+
+TEST_F(InteractomeFixture, SnapshotRoundTripTest) {
+    std::string ranges = "0 1\n2 2\n3 4\n5 5\n";
+    std::istringstream ss(ranges);
+    interactome.readTypeRanges(ss);
+    auto path = (std::filesystem::temp_directory_path() / "interactome_snapshot_test.bin").string();
+    interactome.writeSnapshot(path);
+
+    Interactome mapped = Interactome::readSnapshot(path);
+    ASSERT_THAT(mapped.getNodes(), UnorderedElementsAreArray({1, 2, 3, 4, 5}));
+    auto simple_entities = mapped.getSimpleEntityNeighbors(4);
+    ASSERT_THAT(std::vector<int>(simple_entities.begin(), simple_entities.end()), ElementsAre(5));
+    auto interactors = mapped.getInteractors(2);
+    ASSERT_THAT(std::vector<int>(interactors.begin(), interactors.end()), ElementsAre(1, 3));
+    ASSERT_EQ(mapped.getNodeName(4), "D");
+    ASSERT_TRUE(mapped.hasNode("E"));
+    ASSERT_FALSE(mapped.hasNode("F"));
+    ASSERT_EQ(mapped.getEndIndex(proteoforms), 4);
+    std::filesystem::remove(path);
+}
+
+TEST_F(InteractomeFixture, SnapshotCanBeModifiedAfterMappingTest) {
+    auto path = (std::filesystem::temp_directory_path() / "interactome_snapshot_modified_test.bin").string();
+    interactome.writeSnapshot(path);
+
+    Interactome mapped = Interactome::readSnapshot(path);
+    std::vector<std::pair<int, int>> interactions = {std::make_pair(3, 4)};
+    mapped.addInteractions(interactions);
+    auto interactors = mapped.getInteractors(4);
+    ASSERT_THAT(std::vector<int>(interactors.begin(), interactors.end()), ElementsAre(3, 5));
+    ASSERT_EQ(mapped.getNodeName(3), "C");
+    std::filesystem::remove(path);
+}
+
+TEST_F(InteractomeFixture, RewriteSnapshotWhileMappedTest) {
+    auto path = (std::filesystem::temp_directory_path() / "interactome_snapshot_rewrite_test.bin").string();
+    interactome.writeSnapshot(path);
+    Interactome mapped = Interactome::readSnapshot(path);
+
+    std::vector<std::pair<int, int>> interactions = {std::make_pair(3, 4)};
+    interactome.addInteractions(interactions);
+    interactome.writeSnapshot(path);
+
+    // The old mapping keeps the old file, and the new readers see the complete new one
+    ASSERT_EQ(mapped.getNumInteractions(), 3);
+    ASSERT_EQ(Interactome::readSnapshot(path).getNumInteractions(), 4);
+    ASSERT_FALSE(std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+}
+
+TEST_F(InteractomeFixture, ReadSnapshotOfInvalidFileThrowsExceptionTest) {
+    auto path = (std::filesystem::temp_directory_path() / "interactome_snapshot_invalid_test.bin").string();
+    std::ofstream(path) << "1 2\n2 3\n";
+    ASSERT_THROW(Interactome::readSnapshot(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_F(InteractomeFixture, ReadEdgesMergesInteractionsTest) {
+    auto path = (std::filesystem::temp_directory_path() / "interactome_edges_test.tsv").string();
+    std::ofstream(path) << "3\t5\n\n6 2\r\n5\t3";
+    interactome.readEdges(path);
+
+    ASSERT_THAT(interactome.getNodes(), UnorderedElementsAreArray({1, 2, 3, 4, 5, 6}));
+    auto interactors = interactome.getInteractors(3);
+    ASSERT_THAT(std::vector<int>(interactors.begin(), interactors.end()), ElementsAre(2, 5));
+    interactors = interactome.getInteractors(2);
+    ASSERT_THAT(std::vector<int>(interactors.begin(), interactors.end()), ElementsAre(1, 3, 6));
+    ASSERT_EQ(interactome.getNodeName(1), "A");
+    std::filesystem::remove(path);
+}
+
+TEST_F(InteractomeFixture, ReadEdgesWithInvalidLineThrowsExceptionTest) {
+    auto path = (std::filesystem::temp_directory_path() / "interactome_edges_invalid_test.tsv").string();
+    std::ofstream(path) << "1\t2\n3\tC\n";
+    ASSERT_THROW(interactome.readEdges(path), std::runtime_error);
+    ASSERT_EQ(interactome.getNumInteractions(), 3);
+    std::filesystem::remove(path);
+}
+
+TEST(InteractomeSuite, ReadEdgesOfLargeFileMatchesInteractionListTest) {
+    std::set<std::pair<int, int>> expected;
+    auto path = (std::filesystem::temp_directory_path() / "interactome_large_edges_test.tsv").string();
+    std::ofstream f(path);
+    for (int I = 0; I < 200000; I++) {
+        int a = (I * 7919LL) % 30011, b = (I * 104729LL + 17) % 30011;
+        f << a << "\t" << b << "\n";
+        if (a != b) {
+            expected.emplace(a, b);
+            expected.emplace(b, a);
+        }
+    }
+    f.close();
+
+    Interactome interactome;
+    interactome.readEdges(path);
+
+    ASSERT_EQ(interactome.getNumInteractions() * 2, expected.size());
+    for (int node : interactome.getNodes()) {
+        auto interactors = interactome.getInteractors(node);
+        ASSERT_TRUE(std::is_sorted(interactors.begin(), interactors.end()));
+        for (int neighbor : interactors)
+            ASSERT_TRUE(expected.count({node, neighbor}));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_F(InteractomeFixture, GetTypeOfNodeTest) {
+    std::string ranges = "0 1\n2 2\n3 4\n5 5\n";
+    std::istringstream ss(ranges);
+    interactome.readTypeRanges(ss);
+
+    ASSERT_EQ(interactome.getType(1), genes);
+    ASSERT_EQ(interactome.getType(2), proteins);
+    ASSERT_EQ(interactome.getType("D"), proteoforms);
+    ASSERT_EQ(interactome.getType(5), SimpleEntity);
+    ASSERT_TRUE(interactome.isGene(1));
+    ASSERT_FALSE(interactome.isProtein(3));
+    ASSERT_TRUE(interactome.isProteoform(3));
+    ASSERT_TRUE(interactome.isSimpleEntity(5));
+    ASSERT_FALSE(interactome.isSimpleEntity(6));
+    ASSERT_FALSE(interactome.isSimpleEntity(1000));
+    ASSERT_FALSE(interactome.isSimpleEntity(4));
+}
+
+TEST_F(InteractomeFixture, GetInteractorsByLevelTest) {
+    std::string ranges = "0 1\n2 2\n3 4\n5 6\n";
+    std::istringstream ss(ranges);
+    interactome.readTypeRanges(ss);
+    std::vector<std::pair<int, int>> interactions = {
+            std::make_pair(2, 6),
+            std::make_pair(2, 4)
+    };
+    interactome.addInteractions(interactions);
+
+    auto to_vector = [](std::span<const int> s) { return std::vector<int>(s.begin(), s.end()); };
+    ASSERT_THAT(to_vector(interactome.getGeneNeighbors(2)), ElementsAre(1));
+    ASSERT_THAT(to_vector(interactome.getProteinNeighbors(2)), ElementsAre());
+    ASSERT_THAT(to_vector(interactome.getProteoformNeighbors(2)), ElementsAre(3, 4));
+    ASSERT_THAT(to_vector(interactome.getSimpleEntityNeighbors(2)), ElementsAre(6));
+    ASSERT_THAT(to_vector(interactome.getSimpleEntityNeighbors(4)), ElementsAre(5));
+    ASSERT_THAT(to_vector(interactome.getProteinNeighbors(6)), ElementsAre(2));
+}
+
+TEST_F(InteractomeFixture, GetInteractorsByLevelWithoutRangesThrowsExceptionTest) {
+    ASSERT_THROW((void) interactome.getInteractors(2, genes), std::logic_error);
+}
+
+TEST_F(InteractomeFixture, AddNodeOutOfTypeRangesThrowsExceptionTest) {
+    std::string ranges = "0 1\n2 2\n3 4\n5 5\n";
+    std::istringstream ss(ranges);
+    interactome.readTypeRanges(ss);
+    std::vector<std::pair<int, int>> interactions = {std::make_pair(2, 6)};
+
+    ASSERT_THROW(interactome.addInteractions(interactions), std::invalid_argument);
+    ASSERT_EQ(interactome.getNumVertices(), 6);
+}
+
+TEST_F(InteractomeFixture, GetInteractionsOfVertexSetTest) {
+    base::dynamic_bitset<> vertices(interactome.getNumVertices());
+    vertices[1] = true;
+    vertices[2] = true;
+    vertices[3] = true;
+    vertices[5] = true;
+
+    ASSERT_THAT(interactome.getInteractions(vertices),
+                ElementsAre(std::make_pair(1, 2), std::make_pair(2, 3)));
+}
+
+TEST_F(InteractomeFixture, GetInteractionsOfManyVertexSetsTest) {
+    vb vertex_sets(3, base::dynamic_bitset<>(interactome.getNumVertices()));
+    vertex_sets[0][2] = true;
+    vertex_sets[0][3] = true;
+    vertex_sets[1][4] = true;
+    vertex_sets[1][5] = true;
+    vertex_sets[1][1] = true;
+
+    auto interactions = interactome.getInteractions(vertex_sets);
+
+    ASSERT_EQ(interactions.size(), 3);
+    ASSERT_THAT(interactions[0], ElementsAre(std::make_pair(2, 3)));
+    ASSERT_THAT(interactions[1], ElementsAre(std::make_pair(4, 5)));
+    ASSERT_TRUE(interactions[2].empty());
+}
+
+TEST_F(InteractomeFixture, GetInteractionsWithWrongSetSizeThrowsExceptionTest) {
+    base::dynamic_bitset<> vertices(3);
+    ASSERT_THROW(interactome.getInteractions(vertices), std::invalid_argument);
+}
+
+TEST_F(InteractomeFixture, GetIndexOfNodeNameTest) {
+    std::string names = "1 P31749;00046:308,00047:473\n2 P31749;\n3 P31749\n4 D\n5 E";
+    std::istringstream ss(names);
+    interactome.readNodeNames(ss);
+
+    ASSERT_EQ(interactome.index("P31749;00046:308,00047:473"), 1);
+    ASSERT_EQ(interactome.index(std::string_view("P31749;00046:308,00047:473").substr(0, 7)), 2);
+    ASSERT_EQ(interactome.index("P31749"), 3);
+    ASSERT_EQ(interactome.index("P3174"), -1);
+    ASSERT_EQ(interactome.index(""), -1);
+}
+
+TEST_F(InteractomeFixture, InsertInteractionsReportsTouchedNodesTest) {
+    std::vector<std::pair<int, int>> new_interactions = {{1, 3}, {2, 3}, {5, 6}};
+    auto touched = interactome.insertInteractions(new_interactions);
+
+    ASSERT_THAT(touched, ElementsAre(1, 3, 5, 6));
+    ASSERT_TRUE(interactome.hasPendingChanges());
+    ASSERT_EQ(interactome.getNumInteractions(), 5);
+    ASSERT_THAT(std::vector<int>(interactome.getInteractors(3).begin(), interactome.getInteractors(3).end()),
+                ElementsAre(1, 2));
+    ASSERT_THAT(std::vector<int>(interactome.getInteractors(6).begin(), interactome.getInteractors(6).end()),
+                ElementsAre(5));
+}
+
+TEST_F(InteractomeFixture, RemoveInteractionsReportsTouchedNodesTest) {
+    std::vector<std::pair<int, int>> removed = {{3, 2}, {1, 4}};
+    auto touched = interactome.removeInteractions(removed);
+
+    ASSERT_THAT(touched, ElementsAre(2, 3));
+    ASSERT_EQ(interactome.getNumInteractions(), 2);
+    ASSERT_TRUE(interactome.getInteractors(3).empty());
+}
+
+TEST_F(InteractomeFixture, RemoveNodesRemovesTheirInteractionsTest) {
+    auto touched = interactome.removeNodes({2, 7});
+
+    ASSERT_THAT(touched, ElementsAre(1, 2, 3));
+    ASSERT_FALSE(interactome.hasNode(2));
+    ASSERT_FALSE(interactome.hasNode("B"));
+    ASSERT_EQ(interactome.index("B"), -1);
+    ASSERT_EQ(interactome.getNumInteractions(), 1);
+
+    ASSERT_THAT(interactome.insertNodes({2, 3}), ElementsAre(2));
+    ASSERT_EQ(interactome.index("B"), 2);
+}
+
+TEST(InteractomeSuite, InsertOtherNodeAfterRemovingNodeTest) {
+    std::vector<std::pair<int, int>> interactions = {{0, 1}, {2, 3}};
+    Interactome interactome(interactions);
+    std::istringstream names("0 A\n1 B\n2 C\n3 D");
+    interactome.readNodeNames(names);
+
+    interactome.removeNodes({3});
+    ASSERT_THAT(interactome.insertNodes({5}), ElementsAre(5));
+    interactome.addNode(9);
+
+    ASSERT_FALSE(interactome.hasNode(3));
+    ASSERT_EQ(interactome.index("5"), 5);
+    ASSERT_EQ(interactome.index("9"), 9);
+    ASSERT_THAT(interactome.insertNodes({3}), ElementsAre(3));
+    ASSERT_EQ(interactome.index("D"), 3);
+}
+
+TEST_F(InteractomeFixture, CompactMatchesBulkConstructionTest) {
+    std::vector<std::pair<int, int>> inserted = {{1, 5}, {3, 4}};
+    std::vector<std::pair<int, int>> removed = {{4, 5}};
+    interactome.insertInteractions(inserted);
+    interactome.removeInteractions(removed);
+    interactome.compact();
+
+    std::vector<std::pair<int, int>> expected_interactions = {{1, 2}, {2, 3}, {1, 5}, {3, 4}};
+    Interactome expected(expected_interactions);
+
+    ASSERT_FALSE(interactome.hasPendingChanges());
+    ASSERT_EQ(interactome.getNumInteractions(), expected.getNumInteractions());
+    ASSERT_EQ(interactome.getNodes(), expected.getNodes());
+    for (int node : expected.getNodes()) {
+        auto row = interactome.getInteractors(node), expected_row = expected.getInteractors(node);
+        ASSERT_TRUE(std::equal(row.begin(), row.end(), expected_row.begin(), expected_row.end())) << node;
+    }
+}
+
+TEST_F(InteractomeFixture, LevelSlicesIncludePendingChangesTest) {
+    std::istringstream ranges("0 1\n2 2\n3 4\n5 5\n");
+    interactome.readTypeRanges(ranges);
+    std::vector<std::pair<int, int>> inserted = {{2, 1}, {2, 5}};
+    interactome.insertInteractions(inserted);
+
+    ASSERT_THAT(std::vector<int>(interactome.getGeneNeighbors(2).begin(), interactome.getGeneNeighbors(2).end()),
+                ElementsAre(1));
+    ASSERT_THAT(std::vector<int>(interactome.getProteoformNeighbors(2).begin(),
+                                 interactome.getProteoformNeighbors(2).end()), ElementsAre(3));
+    ASSERT_THAT(std::vector<int>(interactome.getSimpleEntityNeighbors(2).begin(),
+                                 interactome.getSimpleEntityNeighbors(2).end()), ElementsAre(5));
+
+    interactome.compact();
+    ASSERT_THAT(std::vector<int>(interactome.getSimpleEntityNeighbors(2).begin(),
+                                 interactome.getSimpleEntityNeighbors(2).end()), ElementsAre(5));
+}
+
+TEST_F(InteractomeFixture, GetSetsWithNodesTest) {
+    vb vertex_sets(3, base::dynamic_bitset<>(interactome.getNumVertices()));
+    vertex_sets[0][1] = true;
+    vertex_sets[1][4] = true;
+    vertex_sets[2][3] = true;
+
+    ASSERT_THAT(getSetsWithNodes(vertex_sets, {3, 4}), ElementsAre(1, 2));
+}
+
+class InteractomeHierarchyFixture : public InteractomeFixture {
+protected:
+    void SetUp() override {
+        InteractomeFixture::SetUp();
+        std::istringstream ranges("0 1\n2 2\n3 4\n5 5\n");
+        interactome.readTypeRanges(ranges);
+        std::istringstream proteins_to_genes("B A\n");
+        interactome.readGenesToProteins(proteins_to_genes);
+        std::istringstream proteins_to_proteoforms("B D\nB C\n");
+        interactome.readProteinsToProteoforms(proteins_to_proteoforms);
+    }
+};
+
+TEST_F(InteractomeHierarchyFixture, GetMappedNodesTest) {
+    ASSERT_THAT(std::vector<int>(interactome.getProteins(1).begin(), interactome.getProteins(1).end()),
+                ElementsAre(2));
+    ASSERT_THAT(std::vector<int>(interactome.getGenes(2).begin(), interactome.getGenes(2).end()), ElementsAre(1));
+    ASSERT_THAT(std::vector<int>(interactome.getProteoforms(2).begin(), interactome.getProteoforms(2).end()),
+                ElementsAre(3, 4));
+    ASSERT_THAT(std::vector<int>(interactome.getProteins(4).begin(), interactome.getProteins(4).end()),
+                ElementsAre(2));
+    ASSERT_TRUE(interactome.getGenes(2).size() == 1 && interactome.getProteins(0).empty());
+    ASSERT_THROW((void) interactome.getProteins(5), std::invalid_argument);
+}
+
+TEST_F(InteractomeHierarchyFixture, ProjectBitsetsBetweenLevelsTest) {
+    base::dynamic_bitset<> gene_set(2), protein_set(1), proteoform_set(2);
+    gene_set[1] = true;
+    proteoform_set[0] = true;
+
+    interactome.project(gene_set, genes, protein_set, proteins);
+    ASSERT_TRUE(protein_set[0]);
+
+    interactome.project(protein_set, proteins, proteoform_set, proteoforms);
+    ASSERT_EQ(proteoform_set.count(), 2);
+
+    interactome.project(proteoform_set, proteoforms, protein_set, proteins);
+    ASSERT_TRUE(protein_set[0]);
+
+    ASSERT_THROW(interactome.project(gene_set, genes, proteoform_set, proteoforms), std::invalid_argument);
+    ASSERT_THROW(interactome.project(gene_set, genes, proteoform_set, proteins), std::invalid_argument);
+}
+
+TEST_F(InteractomeHierarchyFixture, ReadMappingWithWrongLevelsThrowsExceptionTest) {
+    std::istringstream wrong_levels("A B\n");
+    ASSERT_THROW(interactome.readGenesToProteins(wrong_levels), std::invalid_argument);
+    std::istringstream unknown_name("B X\n");
+    ASSERT_THROW(interactome.readProteinsToProteoforms(unknown_name), std::invalid_argument);
+}
+
+TEST_F(InteractomeHierarchyFixture, SnapshotKeepsHierarchyTest) {
+    auto path = (std::filesystem::temp_directory_path() / "interactome_hierarchy_snapshot.bin").string();
+    interactome.writeSnapshot(path);
+    Interactome mapped = Interactome::readSnapshot(path);
+    std::filesystem::remove(path);
+
+    ASSERT_THAT(std::vector<int>(mapped.getProteoforms(2).begin(), mapped.getProteoforms(2).end()),
+                ElementsAre(3, 4));
+    ASSERT_THAT(std::vector<int>(mapped.getGenes(2).begin(), mapped.getGenes(2).end()), ElementsAre(1));
+}
+
+TEST_F(InteractomeFixture, GetMappedNodesWithoutMappingThrowsExceptionTest) {
+    std::istringstream ranges("0 1\n2 2\n3 4\n5 5\n");
+    interactome.readTypeRanges(ranges);
+    ASSERT_THROW((void) interactome.getProteins(1), std::logic_error);
+}
+
+TEST_F(InteractomeFixture, ReorderByDegreePutsHubsFirstTest) {
+    auto reordering = interactome.reorder(NodeOrder::degree);
+    const auto &permuted = reordering.interactome;
+
+    ASSERT_THAT(reordering.inverse, ElementsAre(2, 1, 3, 4, 5, 0));
+    ASSERT_THAT(reordering.forward, ElementsAre(5, 1, 0, 2, 3, 4));
+    ASSERT_EQ(permuted.getNodeName(0), "B");
+    ASSERT_EQ(permuted.index("E"), 4);
+    ASSERT_FALSE(permuted.hasNode(5));
+    ASSERT_THAT(std::vector<int>(permuted.getInteractors(0).begin(), permuted.getInteractors(0).end()),
+                ElementsAre(1, 2));
+    ASSERT_EQ(permuted.getNumInteractions(), interactome.getNumInteractions());
+}
+
+TEST_F(InteractomeHierarchyFixture, ReorderKeepsLevelRangesTest) {
+    auto reordering = interactome.reorder(NodeOrder::reverse_cuthill_mckee);
+    const auto &permuted = reordering.interactome;
+
+    for (int node = 0; node < interactome.getNumVertices(); node++) {
+        ASSERT_EQ(reordering.inverse[reordering.forward[node]], node);
+        ASSERT_EQ(permuted.getType(reordering.forward[node]), interactome.getType(node));
+    }
+    for (int node : interactome.getNodes()) {
+        ASSERT_EQ(permuted.getNodeName(reordering.forward[node]), interactome.getNodeName(node));
+        for (int neighbor : interactome.getInteractors(node)) {
+            auto row = permuted.getInteractors(reordering.forward[node]);
+            ASSERT_TRUE(std::binary_search(row.begin(), row.end(), reordering.forward[neighbor]));
+        }
+    }
+    int protein = reordering.forward[2];
+    ASSERT_EQ(permuted.getProteoforms(protein).size(), 2);
+    ASSERT_EQ(permuted.getGenes(protein)[0], reordering.forward[1]);
+}
+
+TEST(InteractomeSuite, ReverseCuthillMcKeeReducesBandwidthTest) {
+    // Path 0 - 5 - 1 - 4 - 2 - 3
+    std::vector<std::pair<int, int>> path = {{0, 5}, {5, 1}, {1, 4}, {4, 2}, {2, 3}};
+    Interactome interactome(path);
+    auto reordering = interactome.reorder(NodeOrder::reverse_cuthill_mckee);
+
+    for (const auto &[a, b] : path)
+        ASSERT_EQ(std::abs(reordering.forward[a] - reordering.forward[b]), 1);
+}
+
+TEST(InteractomeSuite, PermuteSetOverLevelRangeTest) {
+    base::dynamic_bitset<> set(3);
+    set[0] = true;
+    set[2] = true;
+    std::vector<int> forward = {0, 1, 4, 2, 3};
+
+    auto permuted = permuteSet(set, forward, 2);
+
+    ASSERT_FALSE(permuted[0]);
+    ASSERT_TRUE(permuted[1]);
+    ASSERT_TRUE(permuted[2]);
+}
@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include <scores.hpp>
+#include <interface_sizes.hpp>
+
+// Interface sizes by the definition, over every vertex and interaction
+InterfaceSizes getInterfaceSizesByDefinition(const base::dynamic_bitset<> &V1, const base::dynamic_bitset<> &V2,
+                                             const std::vector<std::pair<int, int>> &interactions) {
+    std::vector<bool> is_interface(V1.size(), false);
+    InterfaceSizes sizes;
+    for (auto [a, b] : interactions) {
+        for (auto [u, v] : {std::make_pair(a, b), std::make_pair(b, a)})
+            if ((V1[u] && V2[u]) || (V1[u] && V2[v]) || (V2[u] && V1[v]))
+                is_interface[u] = true;
+        bool only1 = V1[a] && !V2[a] && V1[b] && !V2[b];
+        bool only2 = !V1[a] && V2[a] && !V1[b] && V2[b];
+        if ((V1[a] || V2[a]) && (V1[b] || V2[b]) && !only1 && !only2)
+            sizes.edges++;
+    }
+    sizes.nodes = std::count(is_interface.begin(), is_interface.end(), true);
+    return sizes;
+}
+
+class InterfaceSizesFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::mt19937 generator(41);
+        std::uniform_int_distribution<int> node(0, 299);
+        std::bernoulli_distribution member(0.08);
+        adjacency.resize(300);
+        for (int I = 0; I < 900; I++) {
+            int a = node(generator), b = node(generator);
+            if (a != b && !adjacency[a].count(b)) {
+                adjacency[a].insert(b);
+                adjacency[b].insert(a);
+                interactions.emplace_back(a, b);
+            }
+        }
+        sets.assign(40, base::dynamic_bitset<>(300));
+        for (auto &set : sets)
+            for (int I = 0; I < 300; I++)
+                if (member(generator))
+                    set[I] = true;
+    }
+
+    vusi adjacency;
+    std::vector<std::pair<int, int>> interactions;
+    vb sets;
+};
+
+TEST(InterfaceSizesSuite, NodesAndEdgesOfTheInterfaceTest) {
+    vusi adjacency(8);
+    for (auto [a, b] : {std::make_pair(0, 1), {1, 2}, {2, 3}, {3, 4}, {1, 5}, {6, 7}}) {
+        adjacency[a].insert(b);
+        adjacency[b].insert(a);
+    }
+    base::dynamic_bitset<> V1(8), V2(8);
+    for (int node : {0, 1, 2})
+        V1[node] = true;
+    for (int node : {2, 3, 5})
+        V2[node] = true;
+
+    auto sizes = getInterfaceSizes(V1, V2, CsrAdjacency(adjacency));
+
+    ASSERT_EQ(sizes.nodes, 4);  // 1, 2, 3 and 5
+    ASSERT_EQ(sizes.edges, 3);  // 1-2, 2-3 and 1-5
+    ASSERT_EQ(calculate_interface_size_nodes(V1, V2, adjacency), 4);
+    ASSERT_EQ(calculate_interface_size_edges(V1, V2, adjacency), 3);
+}
+
+TEST_F(InterfaceSizesFixture, InterfaceSizesMatchDefinitionTest) {
+    CsrAdjacency csr(adjacency);
+    std::vector<std::pair<int, int>> pairs;
+    for (int I1 = 0; I1 < static_cast<int>(sets.size()); I1++)
+        for (int I2 = I1 + 1; I2 < static_cast<int>(sets.size()); I2++)
+            pairs.emplace_back(I1, I2);
+
+    auto sizes = getInterfaceSizes(sets, csr, pairs, 3);
+
+    ASSERT_EQ(sizes.size(), pairs.size());
+    for (auto I = 0u; I < pairs.size(); I++) {
+        const auto &V1 = sets[pairs[I].first], &V2 = sets[pairs[I].second];
+        ASSERT_EQ(sizes[I], getInterfaceSizesByDefinition(V1, V2, interactions));
+        ASSERT_EQ(calculate_interface_size_nodes(V1, V2, adjacency), sizes[I].nodes);
+        ASSERT_EQ(calculate_interface_size_edges(V1, V2, adjacency), sizes[I].edges);
+    }
+}
+
+TEST_F(InterfaceSizesFixture, InterfaceSizesOfPairListTest) {
+    Interactome interactome(interactions);
+    std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> overlap_size =
+            getOverlapSize;
+    PairList<double> overlapping(getScores(sets, overlap_size, 0, 300));
+
+    auto sizes = getInterfaceSizes(sets, CsrAdjacency(interactome), overlapping);
+
+    ASSERT_EQ(sizes.size(), overlapping.size());
+    for (auto I = 0u; I < sizes.size(); I++) {
+        auto [set1, set2] = sizes.getPair(I);
+        ASSERT_EQ(sizes.getValue(I), getInterfaceSizesByDefinition(sets[set1], sets[set2], interactions));
+    }
+}
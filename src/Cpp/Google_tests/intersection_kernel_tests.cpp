@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <bit_matrix.hpp>
+#include <intersection_kernel.hpp>
+
+// Reference intersection size, one block at a time
+std::size_t getIntersectionSize(const BitMatrix::block_type *row1, const BitMatrix::block_type *row2,
+                                std::size_t num_blocks) {
+    std::size_t result = 0;
+    for (std::size_t I = 0; I < num_blocks; I++)
+        result += std::popcount(row1[I] & row2[I]);
+    return result;
+}
+
+class IntersectionKernelFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::mt19937 generator(17);
+        std::bernoulli_distribution member(0.3);
+        vb sets(23, base::dynamic_bitset<>(1100));
+        for (auto &set : sets)
+            for (int I = 0; I < 1100; I++)
+                if (member(generator))
+                    set[I] = true;
+        matrix = BitMatrix(sets);
+        for (auto I = 0u; I < matrix.getNumRows(); I++)
+            rows.push_back(matrix.getRowBlocks(I));
+    }
+
+    BitMatrix matrix{0, 0};
+    std::vector<const BitMatrix::block_type *> rows;
+};
+
+TEST_F(IntersectionKernelFixture, SupportedKernelsMatchTheIntersectionSizesTest) {
+    // Tiles of odd sizes, to cover the groups of rows and the rows at the edges
+    std::span<const BitMatrix::block_type *const> rows_a(rows.data(), 7);
+    std::span<const BitMatrix::block_type *const> rows_b(rows.data() + 5, 18);
+
+    ASSERT_TRUE(isSupported(PopcountKernel::scalar));
+    ASSERT_TRUE(isSupported(getBestPopcountKernel()));
+    for (auto kernel : {PopcountKernel::scalar, PopcountKernel::avx2, PopcountKernel::avx512}) {
+        if (!isSupported(kernel))
+            continue;
+        std::vector<std::uint32_t> counts(rows_a.size() * rows_b.size());
+        getIntersectionCounts(rows_a, rows_b, matrix.getStride(), counts.data(), kernel);
+        for (auto I = 0u; I < rows_a.size(); I++)
+            for (auto J = 0u; J < rows_b.size(); J++)
+                ASSERT_EQ(counts[I * rows_b.size() + J], getIntersectionSize(rows_a[I], rows_b[J], matrix.getStride()))
+                                            << "kernel " << static_cast<int>(kernel) << " pair " << I << " " << J;
+    }
+}
+
+TEST_F(IntersectionKernelFixture, RowsNotFillingCacheLinesThrowTest) {
+    std::uint32_t count;
+    std::span<const BitMatrix::block_type *const> row(rows.data(), 1);
+
+    ASSERT_THROW(getIntersectionCounts(row, row, matrix.getStride() - 1, &count), std::invalid_argument);
+    getIntersectionCounts(row, row, matrix.getStride(), &count, PopcountKernel::scalar);
+    ASSERT_EQ(count, matrix.getRow(0).count());
+}
@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <level_mapping.hpp>
+
+using ::testing::ElementsAre;
+
+TEST(LevelMappingSuite, InverseKeepsSourcesSortedTest) {
+    // Sources 10..12, targets 20..23
+    LevelMapping mapping(10, 3, 20, 4, {{12, 21}, {10, 21}, {10, 20}, {11, 23}, {10, 21}});
+    auto inverse = mapping.inverse();
+
+    ASSERT_THAT(std::vector<int>(mapping.get(10).begin(), mapping.get(10).end()), ElementsAre(20, 21));
+    ASSERT_EQ(inverse.getNumSources(), 4);
+    ASSERT_THAT(std::vector<int>(inverse.get(21).begin(), inverse.get(21).end()), ElementsAre(10, 12));
+    ASSERT_TRUE(inverse.get(22).empty());
+    ASSERT_THROW((void) inverse.get(24), std::out_of_range);
+}
+
+TEST(LevelMappingSuite, ProjectClearsPreviousTargetsTest) {
+    LevelMapping mapping(0, 3, 3, 2, {{0, 3}, {2, 4}});
+    base::dynamic_bitset<> source_set(3), target_set(2);
+    target_set[0] = true;
+    source_set[2] = true;
+
+    mapping.project(source_set, target_set);
+
+    ASSERT_FALSE(target_set[0]);
+    ASSERT_TRUE(target_set[1]);
+    base::dynamic_bitset<> wrong_size(3);
+    ASSERT_THROW(mapping.project(source_set, wrong_size), std::invalid_argument);
+}
+
+TEST(LevelMappingSuite, MappingOutOfRangeThrowsExceptionTest) {
+    ASSERT_THROW(LevelMapping(0, 3, 3, 2, {{0, 5}}), std::out_of_range);
+}
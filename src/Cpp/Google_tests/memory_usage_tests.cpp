@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <filesystem>
+#include <iterator>
+#include <sstream>
+#include <vector>
+#include <memory_usage.hpp>
+#include <Interactome.hpp>
+#include <bimap_str_int.hpp>
+#include "../Module.hpp"
+
+using ::testing::HasSubstr;
+
+// types.hpp defines str as a macro, so the stream is read through its buffer
+std::string writeReport(const memory::MemoryReport &report) {
+    std::stringstream stream;
+    report.write(stream);
+    return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
+TEST(MemoryUsageSuite, HeapBytesMatchCountingAllocatorTest) {
+    memory::AllocationCounter counter;
+    {
+        std::vector<int, memory::CountingAllocator<int>> values{memory::CountingAllocator<int>(counter)};
+        values.resize(1000);
+        ASSERT_EQ(counter.bytes, memory::heapBytes(values));
+
+        base::dynamic_bitset<unsigned, memory::CountingAllocator<unsigned>> set(
+                1000, memory::CountingAllocator<unsigned>(counter));
+        ASSERT_EQ(counter.bytes, memory::heapBytes(values) + memory::heapBytes(set));
+    }
+    ASSERT_EQ(counter.bytes, 0);
+    ASSERT_EQ(counter.allocations, 2);
+    ASSERT_GE(counter.peak, 4000);
+}
+
+TEST(MemoryUsageSuite, BitsetsReportMatchesCountingAllocatorTest) {
+    using counted_bitset = base::dynamic_bitset<unsigned, memory::CountingAllocator<unsigned>>;
+    auto &counter = memory::getDefaultCounter();
+    auto before = counter.bytes.load();
+    {
+        std::vector<counted_bitset, memory::CountingAllocator<counted_bitset>> sets;
+        sets.reserve(3);
+        for (int I = 0; I < 3; I++)
+            sets.emplace_back(200 + 100 * I);
+        vb same_sets = {base::dynamic_bitset<>(200), base::dynamic_bitset<>(300), base::dynamic_bitset<>(400)};
+
+        auto measured = memory::getMemoryReport(counter, "sets");
+        ASSERT_EQ(measured.total() - before, memory::heapBytes(sets));
+        ASSERT_EQ(memory::heapBytes(sets) - sets.capacity() * sizeof(counted_bitset),
+                  memory::getMemoryReport(same_sets).total() - same_sets.capacity() * sizeof(base::dynamic_bitset<>));
+    }
+    ASSERT_EQ(counter.bytes, before);
+}
+
+TEST(MemoryUsageSuite, HeapBytesOfNestedContainersTest) {
+    std::vector<std::string> names = {"short", std::string(100, 'x')};
+    ASSERT_EQ(memory::heapBytes(names), names.capacity() * sizeof(std::string) + names[1].capacity() + 1);
+
+    vb sets(3, base::dynamic_bitset<>(64));
+    auto report = memory::getMemoryReport(sets, "sets");
+    ASSERT_EQ(report.total(), memory::heapBytes(sets));
+}
+
+TEST(MemoryUsageSuite, WriteReportWithMemberPathsTest) {
+    memory::MemoryReport report("Interactome");
+    memory::MemoryReport node_names("node_names");
+    node_names.add("chars", 10);
+    report.add(node_names).add("neighbors", 32);
+
+    ASSERT_EQ(writeReport(report), "member\tbytes\nInteractome\t42\nInteractome.node_names\t10\n"
+                            "Interactome.node_names.chars\t10\nInteractome.neighbors\t32\n");
+}
+
+TEST(MemoryUsageSuite, InteractomeReportCountsNeighborsTest) {
+    std::vector<std::pair<int, int>> interactions = {{1, 2}, {2, 3}, {4, 5}};
+    Interactome interactome(interactions);
+
+    auto report = interactome.getMemoryReport();
+    auto output = writeReport(report);
+
+    ASSERT_THAT(output, HasSubstr("Interactome.neighbors\t" + std::to_string(6 * sizeof(int)) + "\n"));
+    ASSERT_THAT(output, HasSubstr("Interactome.node_names.chars\t"));
+
+    auto path = (std::filesystem::temp_directory_path() / "interactome_memory_snapshot.bin").string();
+    interactome.writeSnapshot(path);
+    auto mapped = Interactome::readSnapshot(path);
+    std::filesystem::remove(path);
+    ASSERT_LT(mapped.getMemoryReport().total(), report.total());
+}
+
+TEST(MemoryUsageSuite, ModuleAndBimapReportsTest) {
+    Module module("module", proteins, 100);
+    module.addEdge(1, 2);
+    Bimap_str_int bimap(vs{"A", "B"});
+
+    ASSERT_EQ(module.getMemoryReport().members.size(), 3);
+    ASSERT_GT(module.getMemoryReport().total(), 0);
+    ASSERT_GT(bimap.getMemoryReport().total(), 0);
+}
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include <numeric>
+#include <random>
+#include <vector>
+#include <scores.hpp>
+#include <minhash.hpp>
+
+class MinHashFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        // Random sets, and near copies of some of them so that there are similar pairs
+        std::mt19937 generator(23);
+        std::uniform_int_distribution<int> entity(0, 499), size(1, 40), other(0, 399);
+        sets.assign(400, base::dynamic_bitset<>(500));
+        for (auto &set : sets)
+            for (int I = size(generator); I > 0; I--)
+                set[entity(generator)] = true;
+        for (int I = 0; I < 100; I++) {
+            sets[other(generator)] = sets[I];
+            sets[I][entity(generator)].flip();
+        }
+    }
+
+    pair_map<double> getJaccardScoresAbove(double threshold) {
+        pair_map<double> result;
+        for (const auto &[pair, value] : getScores(sets, getJaccardSimilarity, 0, 500))
+            if (value >= threshold)
+                result.emplace(pair, value);
+        return result;
+    }
+
+    vb sets;
+};
+
+TEST_F(MinHashFixture, IdenticalSetsHaveIdenticalSignaturesTest) {
+    sets[1] = sets[0];
+    MinHashSignatures signatures(sets, 64);
+
+    ASSERT_EQ(signatures.size(), sets.size());
+    ASSERT_EQ(signatures.estimateJaccardSimilarity(0, 1), 1.0);
+    ASSERT_LT(signatures.estimateJaccardSimilarity(0, 2), 0.5);
+}
+
+TEST_F(MinHashFixture, ApproximateScoresAreExactSubsetTest) {
+    auto expected = getJaccardScoresAbove(0.5);
+    auto result = getApproximateJaccardScores(sets, 0.5, {8, 4});
+
+    ASSERT_LE(result.scores.size(), expected.size());
+    for (const auto &[pair, value] : result.scores)
+        ASSERT_EQ(expected.at(pair), value);
+    ASSERT_GE(result.num_candidates, result.scores.size());
+    ASSERT_GT(result.estimated_recall, 0.0);
+    ASSERT_LE(result.estimated_recall, 1.0);
+    ASSERT_DOUBLE_EQ(result.min_recall, getLshRecall(0.5, {8, 4}));
+}
+
+TEST_F(MinHashFixture, ManyBandsFindAllSimilarPairsTest) {
+    // Pairs over 0.7 are candidates with probability 1 - (1 - 0.7^2)^50, almost 1
+    auto result = getApproximateJaccardScores(sets, 0.7, {50, 2}, 3);
+
+    ASSERT_EQ(result.scores, getJaccardScoresAbove(0.7));
+    ASSERT_GT(result.estimated_recall, 0.99);
+}
+
+TEST(MinHashSuite, OversizedBucketsAreSkippedTest) {
+    vb sets(30, base::dynamic_bitset<>(40));
+    for (int I = 0; I < 20; I++)        // 20 identical sets share a bucket in every band
+        sets[I][3] = true;
+    for (int I = 20; I < 30; I++)
+        sets[I][I] = true;
+    sets[25][7] = true;
+    sets[26][7] = true;
+    sets[26][25] = true;
+    LshParameters parameters{10, 2, 1, 19};
+
+    auto result = getApproximateJaccardScores(sets, 0.5, parameters, 3);
+
+    std::vector<int> expected_skipped(20);
+    std::iota(expected_skipped.begin(), expected_skipped.end(), 0);
+    ASSERT_EQ(result.skipped_sets, expected_skipped);
+    ASSERT_EQ(result.scores.size(), 1u);
+    ASSERT_EQ(result.scores.at({25, 26}), 2.0 / 3);
+
+    parameters.max_bucket_size = 20;
+    ASSERT_EQ(getApproximateJaccardScores(sets, 0.5, parameters).scores.size(), 20u * 19 / 2 + 1);
+}
+
+TEST(MinHashSuite, LshRecallTest) {
+    ASSERT_DOUBLE_EQ(getLshRecall(1.0, {20, 5}), 1.0);
+    ASSERT_DOUBLE_EQ(getLshRecall(0.0, {20, 5}), 0.0);
+    ASSERT_DOUBLE_EQ(getLshRecall(0.5, {2, 1}), 0.75);
+    ASSERT_LT(getLshRecall(0.3, {20, 5}), getLshRecall(0.6, {20, 5}));
+}
+
+TEST(MinHashSuite, InvalidParametersThrowTest) {
+    vb sets(2, base::dynamic_bitset<>(4));
+
+    ASSERT_THROW(MinHashSignatures(sets, 0), std::invalid_argument);
+    ASSERT_THROW(getApproximateJaccardScores(sets, 0.5, {0, 4}), std::invalid_argument);
+}
@@ -0,0 +1,39 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <module_set_collection.hpp>
+
+using ::testing::ElementsAre;
+
+class ModuleSetCollectionFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        vb sets(4, base::dynamic_bitset<>(10));
+        for (int I = 0; I < 3; I++)
+            sets[0][I] = true;
+        sets[1][5] = true;
+        for (int I = 0; I < 5; I++)
+            sets[3][I] = true;
+        modules = ModuleSetCollection(sets);
+    }
+
+    ModuleSetCollection modules;
+};
+
+TEST_F(ModuleSetCollectionFixture, SizesAreCountedTest) {
+    ASSERT_EQ(modules.size(), 4);
+    ASSERT_EQ(modules.getSize(0), 3);
+    ASSERT_EQ(modules.getSize(2), 0);
+    ASSERT_EQ(modules.getSize(3), 5);
+}
+
+TEST_F(ModuleSetCollectionFixture, OrderBySizeTest) {
+    ASSERT_THAT(std::vector<int>(modules.getOrderBySize().begin(), modules.getOrderBySize().end()),
+                ElementsAre(2, 1, 0, 3));
+}
+
+TEST_F(ModuleSetCollectionFixture, GetModulesWithSizesTest) {
+    auto modules_with_sizes = modules.getModulesWithSizes(1, 3);
+    ASSERT_THAT(std::vector<int>(modules_with_sizes.begin(), modules_with_sizes.end()), ElementsAre(1, 0));
+    ASSERT_TRUE(modules.getModulesWithSizes(6, 10).empty());
+}
@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+#include <node_name_table.hpp>
+
+TEST(NodeNameTableSuite, FindsEveryNameTest) {
+    std::vector<std::string> names;
+    for (int I = 0; I < 5000; I++)
+        names.push_back(I % 7 == 0 ? "" : "P" + std::to_string(I * 31) + ";00046:" + std::to_string(I));
+    NodeNameTable table(names);
+
+    ASSERT_EQ(table.size(), 5000);
+    for (int I = 0; I < 5000; I++) {
+        ASSERT_EQ(table.name(I), names[I]);
+        if (!names[I].empty()) {
+            ASSERT_EQ(table.index(names[I]), I);
+        }
+    }
+    ASSERT_EQ(table.index("P31"), -1);
+    ASSERT_EQ(table.getSlots().size(), NodeNameTable::numSlots(5000 - 715));
+}
+
+TEST(NodeNameTableSuite, RepeatedNamesThrowExceptionTest) {
+    std::vector<std::string> names = {"A", "B", "A"};
+    ASSERT_THROW(NodeNameTable table(names), std::invalid_argument);
+}
+
+TEST(NodeNameTableSuite, BuilderAcceptsNodesInAnyOrderTest) {
+    NodeNameTableBuilder builder(4, 3);
+    ASSERT_EQ(builder.add(3, "D"), -1);
+    ASSERT_EQ(builder.add(0, "A"), -1);
+    ASSERT_EQ(builder.add(1, "D"), 3);
+    ASSERT_FALSE(builder.hasName(1));
+    ASSERT_EQ(builder.add(1, "B"), -1);
+
+    NodeNameTable table = builder.build();
+    ASSERT_EQ(table.name(0), "A");
+    ASSERT_EQ(table.name(1), "B");
+    ASSERT_EQ(table.name(2), "");
+    ASSERT_EQ(table.name(3), "D");
+    ASSERT_EQ(table.index("D"), 3);
+}
+
+TEST(NodeNameTableSuite, EmptyTableHasNoNamesTest) {
+    NodeNameTable table;
+    ASSERT_EQ(table.size(), 0);
+    ASSERT_FALSE(table.has("A"));
+}
@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include <scores.hpp>
+#include <pair_storage.hpp>
+
+class PairStorageFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::mt19937 generator(37);
+        std::bernoulli_distribution member(0.05);
+        sets.assign(120, base::dynamic_bitset<>(300));
+        for (auto &set : sets)
+            for (int I = 0; I < 300; I++)
+                if (member(generator))
+                    set[I] = true;
+    }
+
+    vb sets;
+
+    std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> jaccard =
+            getJaccardSimilarity, overlap_size = getOverlapSize;
+};
+
+TEST(PairStorageSuite, TriangularMatrixIndexesTest) {
+    TriangularMatrix<int> matrix(4);
+    matrix(0, 1) = 1;
+    matrix(3, 2) = 6;
+
+    ASSERT_EQ(matrix.size(), 6);
+    ASSERT_EQ(matrix.getIndex(0, 1), 0);
+    ASSERT_EQ(matrix.getIndex(1, 2), 3);
+    ASSERT_EQ(matrix.getIndex(3, 2), 5);
+    ASSERT_EQ(matrix(2, 3), 6);
+    ASSERT_EQ(matrix.getRow(0).size(), 3);
+    ASSERT_EQ(matrix.getRow(3).size(), 0);
+
+    std::vector<std::pair<int, int>> pairs;
+    matrix.forEach([&](int set1, int set2, int) { pairs.emplace_back(set1, set2); });
+    ASSERT_EQ(pairs, (std::vector<std::pair<int, int>>{{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}}));
+}
+
+TEST(PairStorageSuite, PairListLookupTest) {
+    pair_map<double> scores = {{{3, 7}, 0.5}, {{0, 2}, 1.0}, {{3, 4}, 0.25}};
+    PairList<double> list(scores);
+
+    ASSERT_EQ(list.size(), 3);
+    ASSERT_EQ(list.getPair(0), std::make_pair(0, 2));
+    ASSERT_EQ(list.getPair(2), std::make_pair(3, 7));
+    ASSERT_EQ(*list.find(3, 4), 0.25);
+    ASSERT_EQ(list.find(4, 3), nullptr);
+    ASSERT_FALSE(list.contains(1, 2));
+    std::vector<std::pair<std::pair<int, int>, double>> repeated = {{{1, 2}, 1.0}, {{1, 2}, 2.0}};
+    ASSERT_THROW(PairList<double>{repeated}, std::invalid_argument);
+}
+
+TEST(PairStorageSuite, PairHashSeparatesSwappedAndDiagonalPairsTest) {
+    hash_pair hash;
+
+    ASSERT_NE(hash(std::make_pair(1, 2)), hash(std::make_pair(2, 1)));
+    ASSERT_NE(hash(std::make_pair(1, 1)), hash(std::make_pair(2, 2)));
+}
+
+TEST_F(PairStorageFixture, DenseScoresMatchSparseScoresTest) {
+    auto dense = getDenseScores<JaccardScore>(sets);
+    auto sparse = getScores(sets, jaccard, 0, 300);
+
+    ASSERT_EQ(dense.getNumSets(), sets.size());
+    dense.forEach([&](int set1, int set2, double value) {
+        auto it = sparse.find({set1, set2});
+        ASSERT_EQ(value, it == sparse.end() ? 0.0 : it->second);
+    });
+    ASSERT_EQ(getDenseScores(sets, ScoreType::jaccard, 3), dense);
+}
+
+TEST_F(PairStorageFixture, RescoringPairListAndMatrixTest) {
+    auto prev_scores = getScores(sets, overlap_size, 0, 300);
+    auto expected = getScores(sets, jaccard, prev_scores);
+
+    auto list = getScores(sets, jaccard, PairList<double>(prev_scores), 3);
+    ASSERT_EQ(list, PairList<double>(expected));
+
+    auto matrix = getScores(sets, jaccard, getDenseScores<OverlapSizeScore>(sets));
+    matrix.forEach([&](int set1, int set2, double value) {
+        auto it = expected.find({set1, set2});
+        ASSERT_EQ(value, it == expected.end() ? 0.0 : it->second);
+    });
+}
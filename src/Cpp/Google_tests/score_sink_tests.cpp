@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <bitset.h>
+#include <types.hpp>
+#include <scores.hpp>
+#include <score_sink.hpp>
+
+class ScoreSinkFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::mt19937 generator(11);
+        std::bernoulli_distribution member(0.0005);
+        sets.assign(150, base::dynamic_bitset<>(20000));
+        for (auto &set : sets)
+            for (int I = 0; I < 20000; I++)
+                if (member(generator))
+                    set[I] = true;
+    }
+
+    vb sets;
+};
+
+// Keeps all the chunks, and how many arrived
+class CollectingSink : public ScoreSink {
+public:
+    std::vector<ScoredPair> pairs;
+    std::size_t num_chunks = 0;
+    bool finished = false;
+
+    void consume(std::span<const ScoredPair> chunk) override {
+        pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+        num_chunks++;
+    }
+
+    void finish() override { finished = true; }
+};
+
+TEST_F(ScoreSinkFixture, StreamedScoresMatchScoresInMemoryTest) {
+    CollectingSink sink, serial_sink, all_pairs_sink;
+
+    streamScores(sets, sink, 5, 15, false, 100, 4);
+    streamScores(sets, serial_sink, 5, 15, false, 100, 1);
+    streamScores(sets, all_pairs_sink, 0, 20000, true);
+
+    auto expected = getScores<AllOverlapScores>(sets, 5, 15);
+    ASSERT_TRUE(sink.finished);
+    ASSERT_GT(sink.num_chunks, 1);
+    ASSERT_EQ(sink.pairs.size(), expected.size());
+    for (const auto &pair : sink.pairs)
+        ASSERT_EQ(pair.scores, expected.at({pair.module1, pair.module2}));
+    ASSERT_EQ(sink.pairs, serial_sink.pairs);
+    ASSERT_EQ(all_pairs_sink.pairs.size(), sets.size() * (sets.size() - 1) / 2);
+}
+
+TEST_F(ScoreSinkFixture, BinaryScoresRoundTripTest) {
+    std::stringstream file;
+    BinaryScoreSink writer(file);
+    CollectingSink sink, read_sink;
+
+    streamScores(sets, sink, 0, 20000);
+    writer.consume(sink.pairs);
+    writer.finish();
+    readScores(file, read_sink, 7);
+
+    ASSERT_EQ(read_sink.pairs, sink.pairs);
+    ASSERT_GT(read_sink.num_chunks, 1);
+    ASSERT_TRUE(read_sink.finished);
+
+    std::stringstream not_scores("PFNSNAP\nsomething else");
+    ASSERT_THROW(readScores(not_scores, read_sink), std::runtime_error);
+}
+
+TEST_F(ScoreSinkFixture, TopScoresSinkKeepsTheBestPairsTest) {
+    CollectingSink sink;
+    TopScoresSink top_sink(10, ScoreType::jaccard);
+
+    streamScores(sets, sink, 0, 20000);
+    streamScores(sets, top_sink, 0, 20000, false, 50);
+
+    auto expected = sink.pairs;
+    std::sort(expected.begin(), expected.end(), [](const ScoredPair &pair1, const ScoredPair &pair2) {
+        if (pair1.scores.jaccard_similarity != pair2.scores.jaccard_similarity)
+            return pair1.scores.jaccard_similarity > pair2.scores.jaccard_similarity;
+        return std::make_pair(pair1.module1, pair1.module2) < std::make_pair(pair2.module1, pair2.module2);
+    });
+    expected.resize(10);
+    ASSERT_EQ(top_sink.getTopScores(), expected);
+}
+
+std::string readAll(std::istream &input) {
+    return {std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+}
+
+TEST(ScoreSinkSuite, TsvScoreSinkWritesTheOverlapTableTest) {
+    vb sets(3, base::dynamic_bitset<>(4));
+    sets[0][0] = true;
+    sets[0][1] = true;
+    sets[1][1] = true;
+    sets[2][3] = true;
+    std::vector<std::string> names = {"T1", "T2", "T3"};
+    std::stringstream all_pairs, overlapping_pairs;
+    TsvScoreSink all_pairs_sink(all_pairs, names, proteins), overlapping_pairs_sink(overlapping_pairs, names, proteins);
+
+    streamScores(sets, all_pairs_sink, 0, 4, true);
+    streamScores(sets, overlapping_pairs_sink, 0, 4);
+
+    std::string header = "LEVEL\tMODULE1\tMODULE2\tSHARED_ACCESSIONED_ENTITIES\tOVERLAP_COEFFICIENT\tJACCARD_INDEX\n";
+    ASSERT_EQ(readAll(overlapping_pairs), header + "proteins\tT1\tT2\t1\t1\t0.5\n");
+    ASSERT_EQ(readAll(all_pairs), header + "proteins\tT1\tT2\t1\t1\t0.5\n" + "proteins\tT1\tT3\t0\t0\t0\n"
+                               + "proteins\tT2\tT3\t0\t0\t0\n");
+}
+
+TEST(ScoreSinkSuite, PairsWithEmptyModulesShareNothingTest) {
+    vb sets(3, base::dynamic_bitset<>(4));
+    sets[0][1] = true;
+    sets[1][1] = true;
+    CollectingSink sink, all_pairs_sink;
+
+    streamScores(sets, sink, 0, 4);
+    streamScores(sets, all_pairs_sink, 0, 4, true);
+
+    ASSERT_EQ(sink.pairs.size(), 1u);
+    ASSERT_EQ(sink.pairs[0].module1, 0);
+    ASSERT_EQ(sink.pairs[0].module2, 1);
+    ASSERT_EQ(all_pairs_sink.pairs.size(), 3u);
+}
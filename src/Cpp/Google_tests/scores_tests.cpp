@@ -0,0 +1,269 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <bitset.h>
+#include <types.hpp>
+#include <scores.hpp>
+
+class ScoresFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::mt19937 generator(7);
+        std::bernoulli_distribution member(0.05);
+        sets.assign(300, base::dynamic_bitset<>(500));
+        for (auto &set : sets)
+            for (int I = 0; I < 500; I++)
+                if (member(generator))
+                    set[I] = true;
+    }
+
+    vb sets;
+
+    std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> overlap_size =
+            getOverlapSize;
+};
+
+// Scores of all pairs computed with a direct double loop
+pair_map<double> getScoresSerially(const vb &sets,
+                                   const std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> &score,
+                                   int min_module_size, int max_module_size) {
+    pair_map<double> result;
+    for (int I1 = 0; I1 < static_cast<int>(sets.size()); I1++) {
+        long long size1 = sets[I1].count();
+        if (size1 < min_module_size || size1 > max_module_size) continue;
+        for (int I2 = I1 + 1; I2 < static_cast<int>(sets.size()); I2++) {
+            long long size2 = sets[I2].count();
+            if (size2 < min_module_size || size2 > max_module_size) continue;
+            double value = score(sets[I1], sets[I2]);
+            if (value > 0)
+                result[{I1, I2}] = value;
+        }
+    }
+    return result;
+}
+
+TEST_F(ScoresFixture, ParallelScoresMatchSerialScoresTest) {
+    auto expected = getScoresSerially(sets, overlap_size, 20, 30);
+
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(getScores(sets, overlap_size, 20, 30), expected);
+    ASSERT_EQ(getScores(sets, overlap_size, 20, 30, 1), expected);
+    ASSERT_EQ(getScores(sets, overlap_size, 20, 30, 7), expected);
+}
+
+TEST_F(ScoresFixture, ScoresOfFewerThanTwoSetsAreEmptyTest) {
+    ASSERT_TRUE(getScores(sets, overlap_size, 1000, 2000).empty());
+    ASSERT_TRUE(getScores(vb(1, sets[0]), overlap_size, 0, 1000).empty());
+}
+
+TEST_F(ScoresFixture, OverlapCountsMatchBitsetOperationsTest) {
+    for (int I = 0; I + 1 < 50; I++) {
+        auto counts = getOverlapCounts(sets[I], sets[I + 1]);
+        ASSERT_EQ(counts.size1, sets[I].count());
+        ASSERT_EQ(counts.size2, sets[I + 1].count());
+        ASSERT_EQ(counts.intersection_size, (sets[I] & sets[I + 1]).count());
+        ASSERT_EQ(counts.union_size, (sets[I] | sets[I + 1]).count());
+    }
+}
+
+TEST(ScoresSuite, OverlapCountsOfSetsWithDifferentSizesTest) {
+    base::dynamic_bitset<> set1(1000), set2(40);
+    set1[3] = true;
+    set1[999] = true;
+    set2[3] = true;
+    set2[39] = true;
+
+    auto counts = getOverlapCounts(set1, set2);
+
+    ASSERT_EQ(counts.size1, 2);
+    ASSERT_EQ(counts.size2, 2);
+    ASSERT_EQ(counts.intersection_size, 1);
+    ASSERT_EQ(counts.union_size, 3);
+}
+
+TEST(ScoresSuite, JaccardAndOverlapSimilarityTest) {
+    base::dynamic_bitset<> empty1, empty2, set1(5), set2(5);
+    set1[0] = true;
+    set1[1] = true;
+    set2[1] = true;
+    set2[2] = true;
+    set2[3] = true;
+
+    EXPECT_EQ(1, getJaccardSimilarity(empty1, empty2));
+    EXPECT_EQ(1, getOverlapSimilarity(empty1, set1));
+    EXPECT_DOUBLE_EQ(0.25, getJaccardSimilarity(set1, set2));
+    EXPECT_DOUBLE_EQ(0.5, getOverlapSimilarity(set1, set2));
+    EXPECT_EQ(1, getOverlapSize(set2, set1));
+}
+
+TEST_F(ScoresFixture, PrunedScoresMatchThresholdedScoresTest) {
+    ModuleSetCollection modules(sets);
+    std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> jaccard =
+            getJaccardSimilarity;
+
+    for (double threshold : {0.0, 0.05, 0.1, 0.2}) {
+        pair_map<double> expected;
+        for (const auto &[pair, score] : getScoresSerially(sets, jaccard, 15, 35))
+            if (score >= threshold)
+                expected.emplace(pair, score);
+
+        ASSERT_EQ(getScores(modules, jaccard, getJaccardUpperBound, threshold, 15, 35), expected) << threshold;
+    }
+}
+
+TEST_F(ScoresFixture, PrunedOverlapSizeScoresTest) {
+    ModuleSetCollection modules(sets);
+    pair_map<double> expected;
+    for (const auto &[pair, score] : getScoresSerially(sets, overlap_size, 0, 500))
+        if (score >= 3)
+            expected.emplace(pair, score);
+
+    ASSERT_EQ(getScores(modules, overlap_size, getOverlapSizeUpperBound, 3, 0, 500, 3), expected);
+}
+
+TEST(ScoresSuite, UpperBoundsOfScoresTest) {
+    EXPECT_DOUBLE_EQ(0.5, getJaccardUpperBound(4, 2));
+    EXPECT_DOUBLE_EQ(1, getJaccardUpperBound(0, 0));
+    EXPECT_DOUBLE_EQ(1, getOverlapSimilarityUpperBound(3, 7));
+    EXPECT_DOUBLE_EQ(3, getOverlapSizeUpperBound(3, 7));
+}
+
+// Best k scores of each module by scoring all the pairs
+std::vector<std::vector<std::pair<int, double>>>
+getTopScoresExhaustively(const vb &sets,
+                         const std::function<double(const base::dynamic_bitset<> &,
+                                                    const base::dynamic_bitset<> &)> &score, int k) {
+    std::vector<std::vector<std::pair<int, double>>> result(sets.size());
+    for (int I1 = 0; I1 < static_cast<int>(sets.size()); I1++) {
+        for (int I2 = 0; I2 < static_cast<int>(sets.size()); I2++) {
+            double value = score(sets[I1], sets[I2]);
+            if (I1 != I2 && value > 0)
+                result[I1].emplace_back(I2, value);
+        }
+        std::sort(result[I1].begin(), result[I1].end(), [](const auto &a, const auto &b) {
+            return a.second > b.second || (a.second == b.second && a.first < b.first);
+        });
+        if (static_cast<int>(result[I1].size()) > k)
+            result[I1].resize(k);
+    }
+    return result;
+}
+
+TEST_F(ScoresFixture, TopScoresMatchExhaustiveSearchTest) {
+    ModuleSetCollection modules(sets);
+    std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> jaccard =
+            getJaccardSimilarity, overlap = getOverlapSimilarity;
+
+    ASSERT_EQ(getTopScores(modules, jaccard, getJaccardUpperBound, 5), getTopScoresExhaustively(sets, jaccard, 5));
+    ASSERT_EQ(getTopScores(modules, overlap, getOverlapSimilarityUpperBound, 3, 2),
+              getTopScoresExhaustively(sets, overlap, 3));
+    ASSERT_EQ(getTopScores(modules, overlap_size, getOverlapSizeUpperBound, 20),
+              getTopScoresExhaustively(sets, overlap_size, 20));
+}
+
+TEST_F(ScoresFixture, TopScoresWithoutNeighborsTest) {
+    ModuleSetCollection modules(vb(3, base::dynamic_bitset<>(10)));
+
+    auto top_scores = getTopScores(modules, overlap_size, getOverlapSizeUpperBound, 2);
+
+    ASSERT_EQ(top_scores.size(), 3);
+    for (const auto &module_scores : top_scores)
+        ASSERT_TRUE(module_scores.empty());
+    ASSERT_TRUE(getTopScores(ModuleSetCollection(sets), overlap_size, getOverlapSizeUpperBound, 0)[0].empty());
+}
+
+TEST_F(ScoresFixture, PolicyScoresMatchFunctionScoresTest) {
+    std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> jaccard =
+            getJaccardSimilarity, overlap = getOverlapSimilarity;
+
+    ASSERT_EQ(getScores<JaccardScore>(sets, 0, 500), getScores(sets, jaccard, 0, 500));
+    ASSERT_EQ(getScores<OverlapCoefficientScore>(sets, 10, 40, 3), getScores(sets, overlap, 10, 40));
+    ASSERT_EQ(getScores(sets, ScoreType::overlap_size, 20, 30), getScoresSerially(sets, overlap_size, 20, 30));
+}
+
+TEST_F(ScoresFixture, AllOverlapScoresInOnePassTest) {
+    auto scores = getScores<AllOverlapScores>(sets, 0, 500);
+    auto overlap_sizes = getScores(sets, overlap_size, 0, 500);
+
+    ASSERT_EQ(scores.size(), overlap_sizes.size());
+    for (const auto &[pair, value] : scores) {
+        const auto &set1 = sets[pair.first], &set2 = sets[pair.second];
+        ASSERT_EQ(value.overlap_size, overlap_sizes.at(pair));
+        ASSERT_DOUBLE_EQ(value.overlap_similarity, getOverlapSimilarity(set1, set2));
+        ASSERT_DOUBLE_EQ(value.jaccard_similarity, getJaccardSimilarity(set1, set2));
+    }
+}
+
+TEST_F(ScoresFixture, ScoreTypeDispatchOfPrunedAndTopScoresTest) {
+    ModuleSetCollection modules(sets);
+    std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> jaccard =
+            getJaccardSimilarity;
+
+    ASSERT_EQ(getScores(modules, ScoreType::jaccard, 0.1, 15, 35),
+              getScores(modules, jaccard, getJaccardUpperBound, 0.1, 15, 35));
+    ASSERT_EQ(getScores<OverlapSizeScore>(modules, 3, 0, 500, 2),
+              getScores(modules, overlap_size, getOverlapSizeUpperBound, 3, 0, 500));
+    ASSERT_EQ(getTopScores(modules, ScoreType::overlap_size, 20), getTopScoresExhaustively(sets, overlap_size, 20));
+    ASSERT_EQ(getTopScores<JaccardScore>(modules, 5), getTopScoresExhaustively(sets, jaccard, 5));
+}
+
+TEST_F(ScoresFixture, LevelOverlapScoresMatchScoresPerLevelTest) {
+    // The same traits over three levels: the fixture sets as proteoforms, with two per protein and three proteins
+    // per gene
+    vb gene_sets(sets.size(), base::dynamic_bitset<>(100)), protein_sets(sets.size(), base::dynamic_bitset<>(250));
+    for (auto I = 0u; I < sets.size(); I++) {
+        sets[I].visit_set([&](auto proteoform) {
+            protein_sets[I][proteoform / 2] = true;
+            gene_sets[I][proteoform / 6] = true;
+        });
+    }
+    std::array<pair_map<OverlapScores>, 3> expected = {getScores<AllOverlapScores>(gene_sets, 0, 500),
+                                                       getScores<AllOverlapScores>(protein_sets, 0, 500),
+                                                       getScores<AllOverlapScores>(sets, 0, 500)};
+
+    auto rows = getLevelOverlapScores(gene_sets, protein_sets, sets, 3);
+
+    ASSERT_EQ(rows.size(), expected[genes].size());
+    ASSERT_TRUE(std::is_sorted(rows.begin(), rows.end(), [](const auto &a, const auto &b) {
+        return std::make_pair(a.module1, a.module2) < std::make_pair(b.module1, b.module2);
+    }));
+    for (const auto &row : rows) {
+        std::pair<int, int> pair(row.module1, row.module2);
+        for (int level = genes; level <= proteoforms; level++) {
+            auto it = expected[level].find(pair);
+            ASSERT_EQ(row.levels[level], it == expected[level].end() ? OverlapScores() : it->second);
+        }
+        ASSERT_EQ(row.overlap_size_delta,
+                  static_cast<long long>(row.levels[proteoforms].overlap_size) - row.levels[genes].overlap_size);
+        ASSERT_DOUBLE_EQ(row.jaccard_similarity_delta,
+                         row.levels[proteoforms].jaccard_similarity - row.levels[genes].jaccard_similarity);
+    }
+}
+
+TEST(ScoresSuite, WriteLevelOverlapScoresTest) {
+    vb gene_sets(2, base::dynamic_bitset<>(4)), protein_sets(2, base::dynamic_bitset<>(4)),
+            proteoform_sets(2, base::dynamic_bitset<>(4));
+    gene_sets[0][1] = true;
+    gene_sets[1][1] = true;
+    protein_sets[0][2] = true;
+    protein_sets[1][2] = true;
+    protein_sets[0][3] = true;
+    proteoform_sets[0][0] = true;
+    proteoform_sets[1][3] = true;
+    auto rows = getLevelOverlapScores(gene_sets, protein_sets, proteoform_sets);
+    std::stringstream output;
+
+    writeLevelOverlapScores(output, rows, {"T1", "T2"});
+
+    std::string header, row;
+    std::getline(output, header);
+    std::getline(output, row);
+    ASSERT_EQ(header, "MODULE1\tMODULE2\tGENES_SHARED_ACCESSIONED_ENTITIES\tGENES_OVERLAP_COEFFICIENT\tGENES_JACCARD_INDEX"
+                      "\tPROTEINS_SHARED_ACCESSIONED_ENTITIES\tPROTEINS_OVERLAP_COEFFICIENT\tPROTEINS_JACCARD_INDEX"
+                      "\tPROTEOFORMS_SHARED_ACCESSIONED_ENTITIES\tPROTEOFORMS_OVERLAP_COEFFICIENT"
+                      "\tPROTEOFORMS_JACCARD_INDEX\tSHARED_ACCESSIONED_ENTITIES_DELTA\tOVERLAP_COEFFICIENT_DELTA"
+                      "\tJACCARD_INDEX_DELTA");
+    ASSERT_EQ(row, "T1\tT2\t1\t1\t1\t1\t1\t0.5\t0\t0\t0\t-1\t-1\t-1");
+    ASSERT_THROW(getLevelOverlapScores(gene_sets, protein_sets, vb(3)), std::invalid_argument);
+}
@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include <scores.hpp>
+#include <similarity_join.hpp>
+
+class SimilarityJoinFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        // Entities with skewed frequencies, and near copies of some sets so that there are similar pairs
+        std::mt19937 generator(17);
+        std::geometric_distribution<int> entity(0.02);
+        std::uniform_int_distribution<int> size(0, 30), other(0, 299), coin(0, 3);
+        sets.assign(300, base::dynamic_bitset<>(400));
+        for (auto &set : sets)
+            for (int I = size(generator); I > 0; I--)
+                set[std::min(entity(generator), 399)] = true;
+        for (int I = 0; I < 100; I++) {
+            sets[other(generator)] = sets[I];
+            if (coin(generator) == 0)
+                sets[I][std::min(entity(generator), 399)].flip();
+        }
+    }
+
+    // Pairs with a score of at least threshold, from all the pairs scored with the bitset functions
+    pair_map<double> getScoresAbove(ScoreType type, double threshold) {
+        std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> score =
+                type == ScoreType::jaccard ? getJaccardSimilarity
+                                           : type == ScoreType::overlap_coefficient ? getOverlapSimilarity
+                                                                                    : getOverlapSize;
+        pair_map<double> result;
+        for (const auto &[pair, value] : getScores(sets, score, 0, 400))
+            if (value >= threshold)
+                result.emplace(pair, value);
+        return result;
+    }
+
+    vb sets;
+};
+
+TEST_F(SimilarityJoinFixture, JaccardJoinMatchesAllPairsTest) {
+    for (double threshold : {0.0, 0.1, 0.3, 0.5, 0.8, 1.0}) {
+        auto expected = getScoresAbove(ScoreType::jaccard, threshold);
+        ASSERT_EQ(getSimilarityJoin(sets, ScoreType::jaccard, threshold), expected) << threshold;
+    }
+}
+
+TEST_F(SimilarityJoinFixture, OverlapCoefficientJoinMatchesAllPairsTest) {
+    for (double threshold : {0.2, 0.5, 0.9, 1.0}) {
+        auto expected = getScoresAbove(ScoreType::overlap_coefficient, threshold);
+        ASSERT_EQ(getSimilarityJoin(sets, ScoreType::overlap_coefficient, threshold, 3), expected) << threshold;
+    }
+}
+
+TEST_F(SimilarityJoinFixture, OverlapSizeJoinMatchesAllPairsTest) {
+    for (double threshold : {1.0, 4.0, 10.0}) {
+        auto expected = getScoresAbove(ScoreType::overlap_size, threshold);
+        ASSERT_EQ(getSimilarityJoin(sets, ScoreType::overlap_size, threshold), expected) << threshold;
+    }
+}
+
+TEST(SimilarityJoinSuite, SetsOverDifferentEntitiesThrowTest) {
+    vb sets = {base::dynamic_bitset<>(4), base::dynamic_bitset<>(5)};
+
+    ASSERT_THROW(getSimilarityJoin(sets, ScoreType::jaccard, 0.5), std::invalid_argument);
+}
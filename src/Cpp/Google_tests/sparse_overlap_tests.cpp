@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <random>
+#include <vector>
+#include <scores.hpp>
+#include <sparse_overlap.hpp>
+
+using ::testing::ElementsAre;
+
+class SparseOverlapFixture : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        // Small sets over a large universe, so most pairs are disjoint
+        std::mt19937 generator(11);
+        std::uniform_int_distribution<int> entity(0, 1999), size(0, 12);
+        sets.assign(400, base::dynamic_bitset<>(2000));
+        for (auto &set : sets)
+            for (int I = size(generator); I > 0; I--)
+                set[entity(generator)] = true;
+    }
+
+    vb sets;
+};
+
+TEST_F(SparseOverlapFixture, SparseScoresMatchBitsetScoresTest) {
+    std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> jaccard =
+            getJaccardSimilarity, overlap = getOverlapSimilarity, overlap_size = getOverlapSize;
+
+    ASSERT_EQ(getSparseScores(sets, &OverlapCounts::getJaccardSimilarity, 0, 100), getScores(sets, jaccard, 0, 100));
+    ASSERT_EQ(getSparseScores(sets, &OverlapCounts::getOverlapSimilarity, 0, 100, 3),
+              getScores(sets, overlap, 0, 100));
+    ASSERT_EQ(getSparseScores(sets, &OverlapCounts::getOverlapSize, 2, 8), getScores(sets, overlap_size, 2, 8));
+}
+
+TEST(SparseOverlapSuite, PostingListsOfSelectedSetsTest) {
+    vb sets(3, base::dynamic_bitset<>(4));
+    sets[0][1] = true;
+    sets[1][1] = true;
+    sets[1][3] = true;
+    sets[2][1] = true;
+    std::vector<int> selected = {0, 1};
+
+    PostingLists posting_lists(sets, selected);
+
+    ASSERT_EQ(posting_lists.getNumEntities(), 4);
+    ASSERT_THAT(std::vector<int>(posting_lists.get(1).begin(), posting_lists.get(1).end()), ElementsAre(0, 1));
+    ASSERT_TRUE(posting_lists.get(0).empty());
+    ASSERT_THAT(std::vector<int>(posting_lists.get(3).begin(), posting_lists.get(3).end()), ElementsAre(1));
+}
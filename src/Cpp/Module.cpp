@@ -67,5 +67,10 @@ const std::map<int, std::set<int>> &Module::getAdj() const {
     return adj;
 }
 
-
-
+memory::MemoryReport Module::getMemoryReport() const {
+    memory::MemoryReport report("Module");
+    report.add("name", memory::heapBytes(name));
+    report.add("adj", memory::heapBytes(adj));
+    report.add("accessioned_entity_vertices", memory::heapBytes(accessioned_entity_vertices));
+    return report;
+}
@@ -8,6 +8,7 @@
 #include <vector>
 #include "Interactome.hpp"
 #include "types.hpp"
+#include "memory_usage.hpp"
 
 class Module {
     std::string name;
@@ -41,6 +42,8 @@ public:
     const std::string &getName() const;
 
     Level getLevel() const;
+
+    memory::MemoryReport getMemoryReport() const;
 };
 
 
@@ -226,7 +226,7 @@ namespace base {
          }
 
          constexpr std::size_t count( ) const noexcept {
-            return transform_reduce(block_begin( ), block_end( ), std::size_t(0), std::plus{ }, FUNCTOR(popcount));
+            return base::transform_reduce(block_begin( ), block_end( ), std::size_t(0), std::plus{ }, FUNCTOR(popcount));
          }
 
          constexpr std::size_t count_n(std::size_t i, std::size_t n) const noexcept {
@@ -473,7 +473,7 @@ namespace base {
 
    template<std::size_t N>
    constexpr std::size_t popcount(const wide_scalar<N>& v) noexcept {
-      return transform_reduce(v.simd_sequence( ).begin( ), v.simd_sequence( ).end( ), std::size_t(0), std::plus{ }, [](const auto& s) noexcept {
+      return base::transform_reduce(v.simd_sequence( ).begin( ), v.simd_sequence( ).end( ), std::size_t(0), std::plus{ }, [](const auto& s) noexcept {
          if constexpr(std::is_same_v<typename wide_scalar<N>::simd_type, simd512i>) {
             return _mm512_reduce_add_epi64(_mm512_popcnt_epi64(s.builtin( )));
          } else {
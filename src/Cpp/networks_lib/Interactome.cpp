@@ -1,304 +1,902 @@
 #include "Interactome.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <stdexcept>
+#include <unordered_set>
+#include "snapshot.hpp"
+#include "parallel.hpp"
 
-Interactome::Interactome() {
+Interactome::Interactome() : offsets(std::vector<int>(1, 0)) {
 
 }
 
-Interactome::Interactome(std::vector<std::pair<int, int>> &interactions) {
-    for (auto &interaction: interactions) {
-        addNode(interaction.first);
-        addNode(interaction.second);
-        adj_list.at(interaction.first).insert(interaction.second);
-        adj_list.at(interaction.second).insert(interaction.first);
+Interactome::Interactome(std::vector<std::pair<int, int>> &interactions) : Interactome() {
+    addInteractions(interactions);
+}
+
+void Interactome::addInteractions(std::vector<std::pair<int, int>> &interactions) {
+    mergeInteractions({std::span<const std::pair<int, int>>(interactions)});
+}
+
+namespace {
+    constexpr int ROWS_PER_TASK = 4096;
+    constexpr std::size_t MIN_CHUNK_BYTES = 1 << 16;
+
+    // Calls row_function(node) for every node, in parallel over blocks of consecutive rows.
+    template<typename F>
+    void forEachRow(int num_vertices, F &&row_function) {
+        parallelFor((num_vertices + ROWS_PER_TASK - 1) / ROWS_PER_TASK, [&](std::size_t task) {
+            int last = std::min<int>(num_vertices, (task + 1) * ROWS_PER_TASK);
+            for (int node = task * ROWS_PER_TASK; node < last; node++)
+                row_function(node);
+        });
+    }
+
+    const char *skipBlanks(const char *it, const char *end) {
+        while (it != end && (*it == ' ' || *it == '\t' || *it == '\r'))
+            it++;
+        return it;
+    }
+
+    // Parses the lines of one chunk of an edge file. The chunk starts at a line start and ends after a newline.
+    std::vector<std::pair<int, int>> parseEdges(const char *begin, const char *end, const char *file_begin,
+                                                std::string_view file_edges) {
+        std::vector<std::pair<int, int>> edges;
+        edges.reserve((end - begin) / 8);
+
+        const char *it = begin;
+        while (it != end) {
+            const char *line_begin = it;
+            it = skipBlanks(it, end);
+            if (it == end)
+                break;
+            if (*it == '\n') {                    // Empty line
+                it++;
+                continue;
+            }
+
+            int values[2];
+            for (int &value : values) {
+                it = skipBlanks(it, end);
+                auto[ptr, ec] = std::from_chars(it, end, value);
+                if (ec != std::errc() || value < 0) {
+                    std::string message = "Invalid interaction at byte ";
+                    message += std::to_string(line_begin - file_begin) + " of ";
+                    message += file_edges;
+                    throw std::runtime_error(message);
+                }
+                it = ptr;
+            }
+            it = skipBlanks(it, end);
+            if (it != end && *it != '\n') {
+                std::string message = "Expected two node indexes per line at byte ";
+                message += std::to_string(line_begin - file_begin) + " of ";
+                message += file_edges;
+                throw std::runtime_error(message);
+            }
+            if (it != end)
+                it++;
+            edges.emplace_back(values[0], values[1]);
+        }
+        return edges;
+    }
+}
+
+void Interactome::readEdges(std::string_view file_edges) {
+    MappedFile file(file_edges);
+    const char *begin = file.data(), *end = file.data() + file.size();
+
+    // Split at the first newline after each evenly spaced position
+    std::size_t num_chunks = std::max<std::size_t>(1, std::min<std::size_t>(4 * getNumThreads(),
+                                                                            file.size() / MIN_CHUNK_BYTES));
+    std::vector<const char *> bounds = {begin};
+    for (std::size_t c = 1; c < num_chunks; c++) {
+        const char *position = std::max(bounds.back(), begin + file.size() * c / num_chunks);
+        position = std::find(position, end, '\n');
+        bounds.push_back(position == end ? end : position + 1);
     }
+    bounds.push_back(end);
+
+    std::vector<std::vector<std::pair<int, int>>> edges(num_chunks);
+    parallelFor(num_chunks, [&](std::size_t c) {
+        edges[c] = parseEdges(bounds[c], bounds[c + 1], begin, file_edges);
+    });
+
+    std::vector<std::span<const std::pair<int, int>>> chunks(edges.begin(), edges.end());
+    mergeInteractions(chunks);
+}
+
+// Rebuilds the CSR arrays with the previous adjacency and the new interactions in parallel:
+// a counting pass sizes the rows, a scatter pass fills them, then each row is sorted and deduplicated.
+void Interactome::mergeInteractions(const std::vector<std::span<const std::pair<int, int>>> &chunks) {
+    if (chunks.empty())
+        return;
+    compact();
+    std::vector<int> chunk_max(chunks.size(), -1);
+    parallelFor(chunks.size(), [&](std::size_t c) {
+        for (const auto &interaction : chunks[c]) {
+            if (interaction.first < 0 || interaction.second < 0)
+                throw std::invalid_argument("Provided interaction with a negative node index.");
+            chunk_max[c] = std::max({chunk_max[c], interaction.first, interaction.second});
+        }
+    });
+    const int num_vertices = std::max(getNumVertices(), *std::max_element(chunk_max.begin(), chunk_max.end()) + 1);
+    checkInTypeRanges(num_vertices - 1);
+
+    std::vector<std::atomic<int>> degrees(num_vertices);
+    std::vector<std::atomic<bool>> appears(num_vertices);
+    parallelFor(chunks.size(), [&](std::size_t c) {
+        for (const auto &interaction : chunks[c]) {
+            appears[interaction.first].store(true, std::memory_order_relaxed);
+            appears[interaction.second].store(true, std::memory_order_relaxed);
+            if (interaction.first == interaction.second)
+                continue;
+            degrees[interaction.first].fetch_add(1, std::memory_order_relaxed);
+            degrees[interaction.second].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    std::vector<int> new_nodes;
+    for (int node = 0; node < num_vertices; node++)
+        if (appears[node] && !hasNode(node))
+            new_nodes.push_back(node);
+    addNodes(new_nodes);
+
+    std::vector<int> new_offsets(num_vertices + 1, 0);
+    for (int node = 0; node < num_vertices; node++)
+        new_offsets[node + 1] = new_offsets[node] + (offsets[node + 1] - offsets[node]) + degrees[node];
+
+    // Scatter: previous neighbors go first in each row, the new ones are appended through atomic positions
+    std::vector<int> new_neighbors(new_offsets.back());
+    std::vector<std::atomic<int>> position(num_vertices);
+    forEachRow(num_vertices, [&](int node) {
+        auto previous = neighbors.view().subspan(offsets[node], offsets[node + 1] - offsets[node]);
+        std::copy(previous.begin(), previous.end(), new_neighbors.begin() + new_offsets[node]);
+        position[node].store(new_offsets[node] + previous.size(), std::memory_order_relaxed);
+    });
+    parallelFor(chunks.size(), [&](std::size_t c) {
+        for (const auto &interaction : chunks[c]) {
+            if (interaction.first == interaction.second)
+                continue;
+            new_neighbors[position[interaction.first].fetch_add(1, std::memory_order_relaxed)] = interaction.second;
+            new_neighbors[position[interaction.second].fetch_add(1, std::memory_order_relaxed)] = interaction.first;
+        }
+    });
+
+    // Sort each row and count its distinct neighbors, then compact the rows into the final arrays
+    std::vector<int> row_sizes(num_vertices);
+    forEachRow(num_vertices, [&](int node) {
+        auto row_begin = new_neighbors.begin() + new_offsets[node];
+        auto row_end = new_neighbors.begin() + new_offsets[node + 1];
+        std::sort(row_begin, row_end);
+        row_sizes[node] = std::unique(row_begin, row_end) - row_begin;
+    });
+
+    std::vector<int> final_offsets(num_vertices + 1, 0);
+    for (int node = 0; node < num_vertices; node++)
+        final_offsets[node + 1] = final_offsets[node] + row_sizes[node];
+
+    std::vector<int> final_neighbors(final_offsets.back());
+    forEachRow(num_vertices, [&](int node) {
+        auto row_begin = new_neighbors.begin() + new_offsets[node];
+        std::copy(row_begin, row_begin + row_sizes[node], final_neighbors.begin() + final_offsets[node]);
+    });
+
+    offsets = FrozenArray<int>(std::move(final_offsets));
+    neighbors = FrozenArray<int>(std::move(final_neighbors));
+    updateLevelSplits();
 }
 
 std::vector<int> Interactome::getNodes() const {
     std::vector<int> nodes;
 
-    for (auto &entry : adj_list)
-        nodes.push_back(entry.first);
+    for (int node = 0; node < getNumVertices(); node++)
+        if (is_node[node])
+            nodes.push_back(node);
 
     return nodes;
 }
 
 void Interactome::addNode(int index) {
-    if(!hasNode(index)){
-        adj_list[index];
-        node_names[index] = std::to_string(index);
+    checkInTypeRanges(index);
+    addNodes({index});
+}
+
+// Adds all the missing nodes at once, named after their index unless the name is taken,
+// and rebuilds the node arrays only if needed.
+void Interactome::addNodes(const std::vector<int> &indexes) {
+    int num_vertices = getNumVertices();
+    for (int index : indexes)
+        num_vertices = std::max(num_vertices, index + 1);
+
+    bool changed = num_vertices != getNumVertices();
+    for (int index : indexes)
+        changed = changed || !hasNode(index);
+    if (!changed)
+        return;
+
+    std::vector<char> new_is_node = is_node.toVector();
+    std::vector<int> new_offsets = offsets.toVector();
+    new_is_node.resize(num_vertices, false);
+    new_offsets.resize(num_vertices + 1, new_offsets.back());
+    for (int index : indexes)
+        new_is_node[index] = true;
+
+    // Removed nodes keep their names, so the names are those kept plus one for each new node without a name
+    auto hasName = [&](int node) { return node < node_names.size() && !node_names.name(node).empty(); };
+    int num_names = 0;
+    for (int node = 0; node < num_vertices; node++)
+        if (hasName(node) || new_is_node[node])
+            num_names++;
+
+    NodeNameTableBuilder builder(num_vertices, num_names);
+    for (int node = 0; node < num_vertices; node++) {
+        if (hasName(node))
+            builder.add(node, node_names.name(node));
+        else if (new_is_node[node])
+            builder.add(node, std::to_string(node));
     }
+
+    if (!level_splits.empty()) {    // The new rows are empty
+        std::vector<int> new_splits = level_splits.toVector();
+        new_splits.resize(3 * num_vertices, new_offsets.back());
+        level_splits = FrozenArray<int>(std::move(new_splits));
+    }
+
+    is_node = FrozenArray<char>(std::move(new_is_node));
+    node_names = builder.build();
+    offsets = FrozenArray<int>(std::move(new_offsets));
 }
 
-std::vector<int> Interactome::getInteractors(int node) const {
-    std::vector<int> neighbors(adj_list.at(node).begin(), adj_list.at(node).end());
-    return neighbors;
+std::span<const int> Interactome::row(int node) const {
+    if (!delta_log.empty()) {
+        auto it = delta_log.find(node);
+        if (it != delta_log.end())
+            return it->second;
+    }
+    return neighbors.view().subspan(offsets[node], offsets[node + 1] - offsets[node]);
+}
+
+std::vector<int> &Interactome::patchedRow(int node) {
+    auto it = delta_log.find(node);
+    if (it == delta_log.end()) {
+        auto current = row(node);
+        it = delta_log.emplace(node, std::vector<int>(current.begin(), current.end())).first;
+    }
+    return it->second;
+}
+
+// Inserts or removes the neighbors listed for each node in its patched row. Returns the nodes whose row changed.
+std::vector<int> Interactome::applyDelta(std::unordered_map<int, std::vector<int>> &changes, bool insert) {
+    std::vector<int> touched;
+    for (auto &[node, changed_neighbors] : changes) {
+        auto &neighbor_list = patchedRow(node);
+        auto previous_size = neighbor_list.size();
+        std::sort(changed_neighbors.begin(), changed_neighbors.end());
+        if (insert) {
+            auto middle = neighbor_list.insert(neighbor_list.end(), changed_neighbors.begin(), changed_neighbors.end());
+            std::inplace_merge(neighbor_list.begin(), middle, neighbor_list.end());
+            neighbor_list.erase(std::unique(neighbor_list.begin(), neighbor_list.end()), neighbor_list.end());
+        } else {
+            std::vector<int> remaining;
+            std::set_difference(neighbor_list.begin(), neighbor_list.end(),
+                                changed_neighbors.begin(), changed_neighbors.end(), std::back_inserter(remaining));
+            neighbor_list = std::move(remaining);
+        }
+        if (neighbor_list.size() != previous_size) {
+            delta_degree += static_cast<long long>(neighbor_list.size()) - static_cast<long long>(previous_size);
+            touched.push_back(node);
+        }
+    }
+    return touched;
+}
+
+std::vector<int> Interactome::insertInteractions(const std::vector<std::pair<int, int>> &interactions) {
+    std::vector<int> endpoints;
+    for (const auto &interaction : interactions) {
+        if (interaction.first < 0 || interaction.second < 0)
+            throw std::invalid_argument("Provided interaction with a negative node index.");
+        endpoints.push_back(interaction.first);
+        endpoints.push_back(interaction.second);
+    }
+    if (!endpoints.empty())
+        checkInTypeRanges(*std::max_element(endpoints.begin(), endpoints.end()));
+
+    std::vector<int> touched = insertNodes(endpoints);
+    std::unordered_map<int, std::vector<int>> additions;
+    for (const auto &interaction : interactions) {
+        if (interaction.first == interaction.second)
+            continue;
+        additions[interaction.first].push_back(interaction.second);
+        additions[interaction.second].push_back(interaction.first);
+    }
+    auto changed = applyDelta(additions, true);
+    touched.insert(touched.end(), changed.begin(), changed.end());
+
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    return touched;
+}
+
+std::vector<int> Interactome::removeInteractions(const std::vector<std::pair<int, int>> &interactions) {
+    std::unordered_map<int, std::vector<int>> removals;
+    for (const auto &interaction : interactions) {
+        if (interaction.first == interaction.second || !hasNode(interaction.first) || !hasNode(interaction.second))
+            continue;
+        removals[interaction.first].push_back(interaction.second);
+        removals[interaction.second].push_back(interaction.first);
+    }
+    auto touched = applyDelta(removals, false);
+    std::sort(touched.begin(), touched.end());
+    return touched;
+}
+
+std::vector<int> Interactome::insertNodes(const std::vector<int> &nodes) {
+    std::vector<int> touched;
+    for (int node : nodes) {
+        if (node < 0)
+            throw std::invalid_argument("Provided negative node index.");
+        checkInTypeRanges(node);
+        if (!hasNode(node))
+            touched.push_back(node);
+    }
+    addNodes(touched);
+
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    return touched;
+}
+
+std::vector<int> Interactome::removeNodes(const std::vector<int> &nodes) {
+    std::vector<int> removed;
+    std::unordered_map<int, std::vector<int>> removals;
+    for (int node : nodes) {
+        if (!hasNode(node))
+            continue;
+        removed.push_back(node);
+        for (int neighbor : row(node)) {
+            removals[neighbor].push_back(node);
+            removals[node].push_back(neighbor);
+        }
+    }
+    auto touched = applyDelta(removals, false);
+
+    std::vector<char> new_is_node = is_node.toVector();
+    for (int node : removed)
+        new_is_node[node] = false;
+    is_node = FrozenArray<char>(std::move(new_is_node));
+
+    touched.insert(touched.end(), removed.begin(), removed.end());
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    return touched;
+}
+
+void Interactome::compact() {
+    if (delta_log.empty())
+        return;
+
+    const int num_vertices = getNumVertices();
+    std::vector<int> new_offsets(num_vertices + 1, 0);
+    for (int node = 0; node < num_vertices; node++)
+        new_offsets[node + 1] = new_offsets[node] + row(node).size();
+
+    std::vector<int> new_neighbors(new_offsets.back());
+    forEachRow(num_vertices, [&](int node) {
+        auto neighbor_list = row(node);
+        std::copy(neighbor_list.begin(), neighbor_list.end(), new_neighbors.begin() + new_offsets[node]);
+    });
+
+    offsets = FrozenArray<int>(std::move(new_offsets));
+    neighbors = FrozenArray<int>(std::move(new_neighbors));
+    delta_log.clear();
+    delta_degree = 0;
+    updateLevelSplits();
+}
+
+std::span<const int> Interactome::getInteractors(int node) const {
+    if (!hasNode(node))
+        throw std::out_of_range("Provided invalid node index to get the interactors: " + std::to_string(node));
+    return row(node);
+}
+
+// Membership is tested on the bitset itself, and only the neighbors after each vertex in its sorted row are checked.
+std::vector<std::pair<int, int>> Interactome::getInteractions(const base::dynamic_bitset<> &vertices) const {
+    if (vertices.size() != static_cast<std::size_t>(getNumVertices()))
+        throw std::invalid_argument("Provided vertex set of size " + std::to_string(vertices.size())
+                                    + " for an interactome with " + std::to_string(getNumVertices()) + " vertices.");
+
+    std::vector<std::pair<int, int>> interactions;
+    vertices.visit_set([&](std::size_t vertex) {
+        auto neighbor_list = row(vertex);
+        auto row_end = neighbor_list.end();
+        for (auto it = std::upper_bound(neighbor_list.begin(), row_end, static_cast<int>(vertex)); it != row_end; it++) {
+            if (vertices[*it])
+                interactions.emplace_back(vertex, *it);
+        }
+    });
+    return interactions;
+}
+
+std::vector<std::vector<std::pair<int, int>>> Interactome::getInteractions(const vb &vertex_sets) const {
+    for (const auto &vertices : vertex_sets)
+        if (vertices.size() != static_cast<std::size_t>(getNumVertices()))
+            throw std::invalid_argument("Provided vertex set of size " + std::to_string(vertices.size())
+                                        + " for an interactome with " + std::to_string(getNumVertices()) + " vertices.");
+
+    std::vector<std::vector<std::pair<int, int>>> interactions(vertex_sets.size());
+    parallelFor(vertex_sets.size(), [&](std::size_t I) {
+        interactions[I] = getInteractions(vertex_sets[I]);
+    });
+    return interactions;
+}
+
+int Interactome::getNumVertices() const {
+    return offsets.size() - 1;
+}
+
+int Interactome::getNumInteractions() const {
+    return (static_cast<long long>(neighbors.size()) + delta_degree) / 2;
 }
 
 bool Interactome::hasNode(int node) const {
-    return adj_list.find(node) != adj_list.end();
+    return 0 <= node && node < getNumVertices() && is_node[node];
 }
 
 bool Interactome::hasNode(std::string_view name) const {
-    return node_indexes.find(name.data()) != node_indexes.end();
+    return index(name) != -1;
+}
+
+int Interactome::index(std::string_view name) const {
+    int node = node_names.index(name);
+    return node != -1 && hasNode(node) ? node : -1;
 }
 
 void Interactome::readNodeNames(std::istream &s) {
-    node_names.clear();
-    std::unordered_set<std::string> names;
-    std::unordered_set<int> nodes_left_to_be_named;
+    int nodes_left_to_be_named = getNodes().size();
+    NodeNameTableBuilder builder(getNumVertices(), nodes_left_to_be_named);
 
     int node;
     std::string name;
 
-    for(auto& entry : adj_list) // Create list of which nodes still need a name
-        nodes_left_to_be_named.insert(entry.first);
-
     while (s >> node >> name) {
-        if(nodes_left_to_be_named.size() == 0)
+        if(nodes_left_to_be_named == 0)
             throw std::invalid_argument("Provided too many arguments to name the nodes.");
-        if(node_names.find(node) != node_names.end())
-            throw std::invalid_argument("Provided repeated node in the names stream: " + std::to_string(node));
         if(!hasNode(node))
             throw std::invalid_argument("Provided name for unexistent node: " + std::to_string(node));
-
-        if (names.find(name) != names.end())
+        if(builder.hasName(node))
+            throw std::invalid_argument("Provided repeated node in the names stream: " + std::to_string(node));
+        if (builder.add(node, name) != -1)
             throw std::invalid_argument("Provided repeated node name in the names stream: " + name);
 
-        node_names.emplace(node, name);
-        node_indexes.emplace(name, node);
-        names.insert(name);
-        nodes_left_to_be_named.erase(node);
+        nodes_left_to_be_named--;
     }
-    if(names.size() < adj_list.size()){
+    if(nodes_left_to_be_named > 0){
         std::string missing = "";
-        for(auto node : nodes_left_to_be_named)
-            missing += std::to_string(node) + " ";
+        for(auto node : getNodes())
+            if (!builder.hasName(node))
+                missing += std::to_string(node) + " ";
         throw std::invalid_argument("The names supplied are less than the number of nodes in the network: Missing nodes are: " + missing);
     }
+    node_names = builder.build();
 }
 
 std::string Interactome::getNodeName(int node) const {
     if(!hasNode(node))
         throw std::invalid_argument("Provided invalid node index to get the name.");
-    return node_names.at(node);
-}
-
-//Level Interactome::get_type(int index) {
-//    if (index <= end_indexes[genes])
-//        return genes;
-//    else if (index <= end_indexes[proteins])
-//        return proteins;
-//    else if (index <= end_indexes[proteoforms])
-//        return proteoforms;
-//    else
-//        return SimpleEntity;
-//}
-//
-//Level Interactome::get_type(std::string_view name) {
-//    return get_type(vertices.index(name.data()));
-//}
-//
-//bool Interactome::isGene(int index) {
-//    return index <= end_indexes[genes];
-//}
-//
-//bool Interactome::isProtein(int index) {
-//    return start_indexes[proteins] <= index && index <= end_indexes[proteins];
-//}
-//
-//bool Interactome::isProteoform(int index) {
-//    return start_indexes[proteoforms] <= index && index <= end_indexes[proteoforms];
-//}
-//
-//bool Interactome::isSimpleEntity(int index) {
-//    return index >= start_indexes[SimpleEntity];
-//}
-//
-//void Interactome::readEdges(std::string_view file_edges) {
-//    std::cout << "Reading edges...\n";
-//    std::ifstream f;
-//    f.open(file_edges.data());
-//
-//    int i1, i2;
-//    while (f >> i1 >> i2) {
-//        if (adj.find(i1) == adj.end()) {
-//            std::set<int> s = {i2};
-//            adj.emplace(i1, s);
-//        } else {
-//            adj[i1].insert(i2);
-//        }
-//
-//        if (adj.find(i2) == adj.end()) {
-//            std::set<int> s = {i1};
-//            adj.emplace(i2, s);
-//        } else {
-//            adj[i2].insert(i1);
-//        }
-//    }
-//    std::cout << "Complete.\n\n";
-//}
-//
-//void Interactome::readRanges(std::string_view file_ranges) {
-//    std::cout << "Reading index ranges.\n";
-//    std::ifstream f;
-//    f.open(file_ranges.data());
-//
-//    int start_index, end_index;
-//    while (f >> start_index >> end_index) {
-//        start_indexes.push_back(start_index);
-//        end_indexes.push_back(end_index);
-//    }
-//    std::cout << "Complete.\n\n";
-//}
-//
+    return std::string(node_names.name(node));
+}
+
+void Interactome::readTypeRanges(std::istream &s) {
+    std::vector<int> starts, ends;
+
+    int start_index, end_index;
+    while (s >> start_index >> end_index) {
+        if (start_index > end_index + 1)
+            throw std::invalid_argument("Provided range with start index after its end index.");
+        if (!ends.empty() && start_index != ends.back() + 1)
+            throw std::invalid_argument("Provided ranges that are not contiguous.");
+        starts.push_back(start_index);
+        ends.push_back(end_index);
+    }
+    if (starts.size() != LEVELS.size())
+        throw std::invalid_argument("Provided " + std::to_string(starts.size()) + " ranges, expected one for each level.");
+    if (starts.front() != 0)
+        throw std::invalid_argument("Provided ranges that do not start at index 0.");
+    if (getNumVertices() > ends.back() + 1)
+        throw std::invalid_argument("Provided ranges that do not cover node " + std::to_string(getNumVertices() - 1));
+
+    start_indexes = std::move(starts);
+    end_indexes = std::move(ends);
+    updateLevelSplits();
+
+    // The mappings are indexed by the previous ranges
+    genes_to_proteins = proteins_to_genes = proteins_to_proteoforms = proteoforms_to_proteins = LevelMapping();
+}
+
+void Interactome::checkInTypeRanges(int index) const {
+    if (!end_indexes.empty() && index > end_indexes.back())
+        throw std::invalid_argument("Provided node out of the type ranges: " + std::to_string(index));
+}
+
+// Finds where each Level starts in every neighbor list, by binary search on the sorted rows.
+void Interactome::updateLevelSplits() {
+    if (start_indexes.empty())
+        return;
+    const int num_vertices = getNumVertices();
+
+    std::vector<int> splits(3 * num_vertices);
+    parallelFor((num_vertices + ROWS_PER_TASK - 1) / ROWS_PER_TASK, [&](std::size_t task) {
+        int last = std::min<int>(num_vertices, (task + 1) * ROWS_PER_TASK);
+        for (int node = task * ROWS_PER_TASK; node < last; node++) {
+            auto row_begin = neighbors.begin() + offsets[node], row_end = neighbors.begin() + offsets[node + 1];
+            for (int level = proteins; level <= SimpleEntity; level++) {
+                row_begin = std::lower_bound(row_begin, row_end, start_indexes[level]);
+                splits[3 * node + level - 1] = row_begin - neighbors.begin();
+            }
+        }
+    });
+    level_splits = FrozenArray<int>(std::move(splits));
+}
+
+Level Interactome::getType(int index) const {
+    if (index <= end_indexes.at(genes))
+        return genes;
+    else if (index <= end_indexes.at(proteins))
+        return proteins;
+    else if (index <= end_indexes.at(proteoforms))
+        return proteoforms;
+    else
+        return SimpleEntity;
+}
+
+Level Interactome::getType(std::string_view name) const {
+    int index = node_names.index(name);
+    if (index == -1) {
+        std::string message = "Provided invalid node name to get the type: ";
+        message += name;
+        throw std::invalid_argument(message);
+    }
+    return getType(index);
+}
+
+bool Interactome::isGene(int index) const {
+    return start_indexes.at(genes) <= index && index <= end_indexes.at(genes);
+}
+
+bool Interactome::isProtein(int index) const {
+    return start_indexes.at(proteins) <= index && index <= end_indexes.at(proteins);
+}
+
+bool Interactome::isProteoform(int index) const {
+    return start_indexes.at(proteoforms) <= index && index <= end_indexes.at(proteoforms);
+}
+
+bool Interactome::isSimpleEntity(int index) const {
+    return start_indexes.at(SimpleEntity) <= index && index <= end_indexes.at(SimpleEntity);
+}
+
+std::span<const int> Interactome::getInteractors(int node, Level level) const {
+    if (!hasNode(node))
+        throw std::out_of_range("Provided invalid node index to get the interactors: " + std::to_string(node));
+    if (level_splits.empty())
+        throw std::logic_error("The type ranges are needed to get the interactors by level.");
+    if (!delta_log.empty() && delta_log.count(node)) {
+        const auto &neighbor_list = delta_log.at(node);
+        auto begin = std::lower_bound(neighbor_list.begin(), neighbor_list.end(), start_indexes[level]);
+        auto end = level == SimpleEntity ? neighbor_list.end()
+                                         : std::lower_bound(begin, neighbor_list.end(), start_indexes[level + 1]);
+        return {neighbor_list.data() + (begin - neighbor_list.begin()), static_cast<std::size_t>(end - begin)};
+    }
+    int begin = level == genes ? offsets[node] : level_splits[3 * node + level - 1];
+    int end = level == SimpleEntity ? offsets[node + 1] : level_splits[3 * node + level];
+    return neighbors.view().subspan(begin, end - begin);
+}
+
+int Interactome::getStartIndex(Level level) const {
+    return start_indexes.at(level);
+}
+
+int Interactome::getEndIndex(Level level) const {
+    return end_indexes.at(level);
+}
+
+void Interactome::writeSnapshot(std::string_view path) const {
+    if (hasPendingChanges()) {
+        Interactome compacted = *this;
+        compacted.compact();
+        compacted.writeSnapshot(path);
+        return;
+    }
+    snapshot::Writer writer(path);
+    writer.write(snapshot::IS_NODE, is_node.view());
+    writer.write(snapshot::OFFSETS, offsets.view());
+    writer.write(snapshot::NEIGHBORS, neighbors.view());
+    writer.write(snapshot::NAME_OFFSETS, node_names.getOffsets().view());
+    writer.write(snapshot::NAME_CHARS, node_names.getChars().view());
+    writer.write(snapshot::NAME_SLOTS, node_names.getSlots().view());
+    writer.write(snapshot::LEVEL_STARTS, std::span<const int>(start_indexes));
+    writer.write(snapshot::LEVEL_ENDS, std::span<const int>(end_indexes));
+    writer.write(snapshot::LEVEL_SPLITS, level_splits.view());
+    writer.write(snapshot::GENE_PROTEIN_OFFSETS, genes_to_proteins.getOffsets().view());
+    writer.write(snapshot::GENE_PROTEIN_TARGETS, genes_to_proteins.getTargets().view());
+    writer.write(snapshot::PROTEIN_GENE_OFFSETS, proteins_to_genes.getOffsets().view());
+    writer.write(snapshot::PROTEIN_GENE_TARGETS, proteins_to_genes.getTargets().view());
+    writer.write(snapshot::PROTEIN_PROTEOFORM_OFFSETS, proteins_to_proteoforms.getOffsets().view());
+    writer.write(snapshot::PROTEIN_PROTEOFORM_TARGETS, proteins_to_proteoforms.getTargets().view());
+    writer.write(snapshot::PROTEOFORM_PROTEIN_OFFSETS, proteoforms_to_proteins.getOffsets().view());
+    writer.write(snapshot::PROTEOFORM_PROTEIN_TARGETS, proteoforms_to_proteins.getTargets().view());
+    writer.close();
+}
+
+Interactome Interactome::readSnapshot(std::string_view path) {
+    snapshot::Reader reader(path);
+    Interactome interactome;
+    interactome.is_node = reader.read<char>(snapshot::IS_NODE);
+    interactome.offsets = reader.read<int>(snapshot::OFFSETS);
+    interactome.neighbors = reader.read<int>(snapshot::NEIGHBORS);
+    interactome.node_names = NodeNameTable(reader.read<int>(snapshot::NAME_OFFSETS),
+                                           reader.read<char>(snapshot::NAME_CHARS),
+                                           reader.read<int>(snapshot::NAME_SLOTS));
+    interactome.start_indexes = reader.read<int>(snapshot::LEVEL_STARTS).toVector();
+    interactome.end_indexes = reader.read<int>(snapshot::LEVEL_ENDS).toVector();
+    interactome.level_splits = reader.read<int>(snapshot::LEVEL_SPLITS);
+
+    auto readMapping = [&](Level source_level, Level target_level, snapshot::Section offsets_section,
+                           snapshot::Section targets_section) {
+        auto mapping_offsets = reader.read<int>(offsets_section);
+        auto mapping_targets = reader.read<int>(targets_section);
+        if (mapping_offsets.empty())
+            return LevelMapping();
+        const auto &starts = interactome.start_indexes, &ends = interactome.end_indexes;
+        if (starts.size() != LEVELS.size()
+            || mapping_offsets.size() != static_cast<std::size_t>(ends[source_level] - starts[source_level] + 2)) {
+            std::string message = "Inconsistent interactome snapshot ";
+            message += path;
+            throw std::runtime_error(message);
+        }
+        return LevelMapping(starts[source_level], starts[target_level], ends[target_level] - starts[target_level] + 1,
+                            std::move(mapping_offsets), std::move(mapping_targets));
+    };
+    interactome.genes_to_proteins = readMapping(genes, proteins, snapshot::GENE_PROTEIN_OFFSETS,
+                                                snapshot::GENE_PROTEIN_TARGETS);
+    interactome.proteins_to_genes = readMapping(proteins, genes, snapshot::PROTEIN_GENE_OFFSETS,
+                                                snapshot::PROTEIN_GENE_TARGETS);
+    interactome.proteins_to_proteoforms = readMapping(proteins, proteoforms, snapshot::PROTEIN_PROTEOFORM_OFFSETS,
+                                                      snapshot::PROTEIN_PROTEOFORM_TARGETS);
+    interactome.proteoforms_to_proteins = readMapping(proteoforms, proteins, snapshot::PROTEOFORM_PROTEIN_OFFSETS,
+                                                      snapshot::PROTEOFORM_PROTEIN_TARGETS);
+
+    // Check only the array sizes, the contents are used as they are
+    const auto num_vertices = interactome.is_node.size();
+    if (interactome.offsets.size() != num_vertices + 1
+        || static_cast<std::size_t>(interactome.offsets.back()) != interactome.neighbors.size()
+        || static_cast<std::size_t>(interactome.node_names.size()) != num_vertices
+        || static_cast<std::size_t>(interactome.node_names.getOffsets().back()) != interactome.node_names.getChars().size()
+        || interactome.node_names.getSlots().size() & (interactome.node_names.getSlots().size() - 1)
+        || interactome.start_indexes.size() != interactome.end_indexes.size()
+        || (interactome.level_splits.size() != 3 * num_vertices
+            && !(interactome.level_splits.empty() && interactome.start_indexes.empty()))) {
+        std::string message = "Inconsistent interactome snapshot ";
+        message += path;
+        throw std::runtime_error(message);
+    }
+    return interactome;
+}
+
 //int Interactome::index(std::string_view name) {
 //    return vertices.index(name.data());
 //}
 
 
 
-//
-//void Interactome::readGenesToProteins(std::string_view file_proteins_to_genes) {
-//    std::cout << "Reading genes to proteins...\n";
-//    std::ifstream f(file_proteins_to_genes.data());
-//
-//    if (!f.is_open()) {
-//        std::string message = "Error reading file ";
-//        message += file_proteins_to_genes;
-//        message += " at: ";
-//        message += __FUNCTION__;
-//        throw std::runtime_error(message);
-//    }
-//
-//    std::string protein_name, gene_name;
-//    while (f >> protein_name >> gene_name) {
-//        int gene_index = index(gene_name), protein_index = index(protein_name);
-//        if (genes_to_proteins.find(gene_index) == genes_to_proteins.end()) {
-//            genes_to_proteins.emplace(gene_index, std::vector<int>(1, protein_index));
-//        } else {
-//            genes_to_proteins[gene_index].push_back(protein_index);
-//        }
-//    }
-//    std::cout << "Complete.\n\n";
-//}
-//
-//void Interactome::readProteinsToProteoforms(std::string_view file_proteins_to_proteoforms) {
-//    std::cout << "Reading proteins to proteoforms.\n";
-//    std::ifstream f(file_proteins_to_proteoforms.data());
-//
-//    if (!f.is_open()) {
-//        std::string message = "Error reading file ";
-//        message += file_proteins_to_proteoforms;
-//        message += " at: ";
-//        message += __FUNCTION__;
-//        throw std::runtime_error(message);
-//    }
-//
-//    std::string protein_name, proteoform_name;
-//    while (f >> protein_name >> proteoform_name) {
-//        int proteoform_index = index(proteoform_name), protein_index = index(protein_name);
-//        if (proteins_to_proteoform.find(protein_index) == proteins_to_proteoform.end()) {
-//            proteins_to_proteoform.emplace(protein_index, proteoform_index);
-//        } else {
-//            proteins_to_proteoform[protein_index].push_back(proteoform_index);
-//        }
-//    }
-//    std::cout << "Complete.\n\n";
-//}
-//
-//Interactome::Interactome(std::string_view file_vertices, std::string_view file_edges, std::string_view file_ranges,
-//                         std::string_view file_proteins_to_genes, std::string_view file_proteins_to_proteoforms)
-//        : vertices(file_vertices) {
-//    readRanges(file_ranges);
-//    readEdges(file_edges);
-//    readGenesToProteins(file_proteins_to_genes);
-//    readProteinsToProteoforms(file_proteins_to_proteoforms);
-//    std::cout << "Finished reading interactome.\n\n";
-//}
-//
-//std::vector<int> Interactome::getProteins(int gene_index) {
-//    return genes_to_proteins[gene_index];
-//}
-//
-//std::vector<int> Interactome::getProteoforms(int protein_index) {
-//    return proteins_to_proteoform[protein_index];
-//}
-//
-//// Returns all types of neighbors of the vertex
-//std::set<int> Interactome::getNeighbors(int index) {
-//    return adj[index];
-//}
-//
-//std::set<int> Interactome::getProteinNeighbors(int index) {
-//    std::set<int> neighbors;
-//    for (auto neighbor : adj[index]) {
-//        if (isProtein(neighbor)) neighbors.insert(neighbor);
-//    }
-//    return neighbors;
-//}
-//
-//std::set<int> Interactome::getProteoformNeighbors(int index) {
-//    std::set<int> neighbors;
-//    for (auto neighbor : adj[index]) {
-//        if (isProteoform(neighbor)) neighbors.insert(neighbor);
-//    }
-//    return neighbors;
-//}
-//
-//std::set<int> Interactome::getSimpleEntityNeighbors(int index) {
-//    std::set<int> neighbors;
-//    for (auto neighbor : adj[index]) {
-//        if (isSimpleEntity(neighbor)) neighbors.insert(neighbor);
-//    }
-//    return neighbors;
-//}
-//
-//bool has(const std::vector<int> &indexes, int index) {
-//    auto lower = lower_bound(indexes.begin(), indexes.end(), index);
-//    return lower != indexes.end() && *lower == index;
-//}
-//
-//// Returns edges between the selected vertices
-//std::vector<std::pair<int, int>> Interactome::getInteractions(std::vector<int> indexes) {
-//    std::vector<std::pair<int, int>> interactions;
-//
-//    std::sort(indexes.begin(), indexes.end());
-//
-//    for (int index : indexes) {
-//        for (int neighbor : getNeighbors(index)) {
-//            if (has(indexes, neighbor)) {
-//                interactions.push_back(std::make_pair(index, neighbor));
-//            }
-//        }
-//    }
-//
-//    return interactions;
-//}
-//
-//int Interactome::getNumVertices() {
-//    return vertices.size();
-//}
-//
-//int Interactome::getStartIndexGenes() {
-//    return start_indexes[genes];
-//}
-//
-//int Interactome::getEndIndexGenes() {
-//    return end_indexes[genes];
-//}
-//
-//int Interactome::getStartIndexProteins() {
-//    return start_indexes[proteins];
-//}
-//
-//int Interactome::getEndIndexProteins() {
-//    return end_indexes[proteins];
-//}
-//
-//int Interactome::getStartIndexProteoforms() {
-//    return start_indexes[proteoforms];
-//}
-//
-//int Interactome::getEndIndexProteoforms() {
-//    return end_indexes[proteoforms];
-//}
\ No newline at end of file
+// Reads pairs of names, the first of target_level and the second of source_level.
+LevelMapping Interactome::readLevelMapping(std::istream &s, Level source_level, Level target_level) const {
+    if (start_indexes.empty())
+        throw std::logic_error("The type ranges are needed to read the mapping between levels.");
+
+    std::vector<std::pair<int, int>> pairs;
+    std::string target_name, source_name;
+    while (s >> target_name >> source_name) {
+        int source = index(source_name), target = index(target_name);
+        if (source == -1 || target == -1)
+            throw std::invalid_argument("Provided unknown node in the mapping: " + (source == -1 ? source_name : target_name));
+        if (getType(source) != source_level || getType(target) != target_level)
+            throw std::invalid_argument("Provided mapping between nodes of the wrong levels: " + target_name + " " + source_name);
+        pairs.emplace_back(source, target);
+    }
+    return LevelMapping(start_indexes[source_level], end_indexes[source_level] - start_indexes[source_level] + 1,
+                        start_indexes[target_level], end_indexes[target_level] - start_indexes[target_level] + 1,
+                        std::move(pairs));
+}
+
+void Interactome::readGenesToProteins(std::istream &s) {
+    genes_to_proteins = readLevelMapping(s, genes, proteins);
+    proteins_to_genes = genes_to_proteins.inverse();
+}
+
+void Interactome::readProteinsToProteoforms(std::istream &s) {
+    // The lines are "protein proteoform", so the proteoforms are read as the source
+    proteoforms_to_proteins = readLevelMapping(s, proteoforms, proteins);
+    proteins_to_proteoforms = proteoforms_to_proteins.inverse();
+}
+
+const LevelMapping &Interactome::getMapping(Level source_level, Level target_level) const {
+    const LevelMapping *mapping;
+    if (source_level == genes && target_level == proteins)
+        mapping = &genes_to_proteins;
+    else if (source_level == proteins && target_level == genes)
+        mapping = &proteins_to_genes;
+    else if (source_level == proteins && target_level == proteoforms)
+        mapping = &proteins_to_proteoforms;
+    else if (source_level == proteoforms && target_level == proteins)
+        mapping = &proteoforms_to_proteins;
+    else
+        throw std::invalid_argument("There is no mapping from " + LEVELS[source_level] + " to " + LEVELS[target_level]);
+    if (mapping->empty())
+        throw std::logic_error("The mapping from " + LEVELS[source_level] + " to " + LEVELS[target_level] + " was not read.");
+    return *mapping;
+}
+
+std::span<const int> Interactome::getProteins(int node) const {
+    if (isGene(node))
+        return getMapping(genes, proteins).get(node);
+    if (isProteoform(node))
+        return getMapping(proteoforms, proteins).get(node);
+    throw std::invalid_argument("Provided node that is not a gene or proteoform: " + std::to_string(node));
+}
+
+std::span<const int> Interactome::getGenes(int protein) const {
+    if (!isProtein(protein))
+        throw std::invalid_argument("Provided node that is not a protein: " + std::to_string(protein));
+    return getMapping(proteins, genes).get(protein);
+}
+
+std::span<const int> Interactome::getProteoforms(int protein) const {
+    if (!isProtein(protein))
+        throw std::invalid_argument("Provided node that is not a protein: " + std::to_string(protein));
+    return getMapping(proteins, proteoforms).get(protein);
+}
+
+void Interactome::project(const base::dynamic_bitset<> &source_set, Level source_level,
+                          base::dynamic_bitset<> &target_set, Level target_level) const {
+    getMapping(source_level, target_level).project(source_set, target_set);
+}
+
+Reordering Interactome::reorder(NodeOrder order) const {
+    if (hasPendingChanges()) {
+        Interactome compacted = *this;
+        compacted.compact();
+        return compacted.reorder(order);
+    }
+    const int num_vertices = getNumVertices();
+    auto degree = [&](int node) { return offsets[node + 1] - offsets[node]; };
+
+    std::vector<int> nodes = getNodes();
+    std::vector<int> sequence;  // Preferred order of the nodes, before placing them in their ranges
+    if (order == NodeOrder::degree) {
+        sequence = nodes;
+        std::stable_sort(sequence.begin(), sequence.end(), [&](int a, int b) { return degree(a) > degree(b); });
+    } else {
+        // Breadth first search from each unvisited node of minimum degree, visiting the neighbors by increasing degree
+        std::stable_sort(nodes.begin(), nodes.end(), [&](int a, int b) { return degree(a) < degree(b); });
+        std::vector<char> visited(num_vertices, false);
+        sequence.reserve(nodes.size());
+        for (int start : nodes) {
+            if (visited[start])
+                continue;
+            visited[start] = true;
+            sequence.push_back(start);
+            for (auto head = sequence.size() - 1; head < sequence.size(); head++) {
+                auto first_new = sequence.size();
+                for (int neighbor : row(sequence[head])) {
+                    if (!visited[neighbor]) {
+                        visited[neighbor] = true;
+                        sequence.push_back(neighbor);
+                    }
+                }
+                std::stable_sort(sequence.begin() + first_new, sequence.end(),
+                                 [&](int a, int b) { return degree(a) < degree(b); });
+            }
+        }
+        std::reverse(sequence.begin(), sequence.end());
+    }
+
+    // Fill each range with its nodes in the preferred order, then its unused indexes
+    std::vector<int> range_starts;     // Of all ranges but the first
+    if (!start_indexes.empty())
+        range_starts.assign(start_indexes.begin() + 1, start_indexes.end());
+    auto rangeOf = [&](int node) {
+        return std::upper_bound(range_starts.begin(), range_starts.end(), node) - range_starts.begin();
+    };
+    std::vector<std::vector<int>> placed(range_starts.size() + 1);
+    for (int node : sequence)
+        placed[rangeOf(node)].push_back(node);
+    for (int node = 0; node < num_vertices; node++)
+        if (!hasNode(node))
+            placed[rangeOf(node)].push_back(node);
+
+    Reordering result;
+    result.inverse.reserve(num_vertices);
+    for (const auto &range_nodes : placed)
+        result.inverse.insert(result.inverse.end(), range_nodes.begin(), range_nodes.end());
+    result.forward.resize(num_vertices);
+    for (int I = 0; I < num_vertices; I++)
+        result.forward[result.inverse[I]] = I;
+
+    const auto &forward = result.forward, &inverse = result.inverse;
+    std::vector<char> new_is_node(num_vertices);
+    std::vector<int> new_offsets(num_vertices + 1, 0);
+    for (int I = 0; I < num_vertices; I++) {
+        new_is_node[I] = is_node[inverse[I]];
+        new_offsets[I + 1] = new_offsets[I] + degree(inverse[I]);
+    }
+    std::vector<int> new_neighbors(new_offsets.back());
+    forEachRow(num_vertices, [&](int node) {
+        auto new_row = new_neighbors.begin() + new_offsets[node];
+        for (int neighbor : row(inverse[node]))
+            *new_row++ = forward[neighbor];
+        std::sort(new_neighbors.begin() + new_offsets[node], new_row);
+    });
+
+    int num_names = 0;
+    for (int node = 0; node < node_names.size(); node++)
+        num_names += !node_names.name(node).empty();
+    NodeNameTableBuilder builder(num_vertices, num_names);
+    for (int node = 0; node < node_names.size(); node++)
+        if (!node_names.name(node).empty())
+            builder.add(forward[node], node_names.name(node));
+
+    Interactome &permuted = result.interactome;
+    permuted.is_node = FrozenArray<char>(std::move(new_is_node));
+    permuted.offsets = FrozenArray<int>(std::move(new_offsets));
+    permuted.neighbors = FrozenArray<int>(std::move(new_neighbors));
+    permuted.node_names = builder.build();
+    permuted.start_indexes = start_indexes;
+    permuted.end_indexes = end_indexes;
+    permuted.updateLevelSplits();
+    permuted.genes_to_proteins = genes_to_proteins.permute(forward);
+    permuted.proteins_to_genes = proteins_to_genes.permute(forward);
+    permuted.proteins_to_proteoforms = proteins_to_proteoforms.permute(forward);
+    permuted.proteoforms_to_proteins = proteoforms_to_proteins.permute(forward);
+    return result;
+}
+
+memory::MemoryReport Interactome::getMemoryReport() const {
+    memory::MemoryReport report("Interactome");
+    report.add(node_names.getMemoryReport());
+    report.add("is_node", is_node.heapBytes());
+    report.add("offsets", offsets.heapBytes());
+    report.add("neighbors", neighbors.heapBytes());
+    report.add("level_ranges", memory::heapBytes(start_indexes) + memory::heapBytes(end_indexes));
+    report.add("level_splits", level_splits.heapBytes());
+    report.add("delta_log", memory::heapBytes(delta_log));
+    report.add(genes_to_proteins.getMemoryReport("genes_to_proteins"));
+    report.add(proteins_to_genes.getMemoryReport("proteins_to_genes"));
+    report.add(proteins_to_proteoforms.getMemoryReport("proteins_to_proteoforms"));
+    report.add(proteoforms_to_proteins.getMemoryReport("proteoforms_to_proteins"));
+    return report;
+}
+
+base::dynamic_bitset<> permuteSet(const base::dynamic_bitset<> &set, const std::vector<int> &forward, int start) {
+    base::dynamic_bitset<> result(set.size());
+    set.visit_set([&](auto position) {
+        int node = start + position;
+        result[(static_cast<std::size_t>(node) < forward.size() ? forward[node] : node) - start] = true;
+    });
+    return result;
+}
+
+std::vector<int> getSetsWithNodes(const vb &vertex_sets, const std::vector<int> &nodes) {
+    std::vector<int> result;
+    for (auto I = 0u; I < vertex_sets.size(); I++) {
+        for (int node : nodes) {
+            if (0 <= node && static_cast<std::size_t>(node) < vertex_sets[I].size() && vertex_sets[I][node]) {
+                result.push_back(I);
+                break;
+            }
+        }
+    }
+    return result;
+}
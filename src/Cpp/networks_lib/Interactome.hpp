@@ -5,12 +5,25 @@
 #include <map>
 #include <vector>
 #include <set>
+#include <span>
 #include "bimap_str_int.hpp"
 #include "types.hpp"
+#include "frozen_array.hpp"
+#include "node_name_table.hpp"
+#include "level_mapping.hpp"
+#include "memory_usage.hpp"
 #include <fstream>
 #include <iostream>
+#include <unordered_map>
 #include <utility>
 
+// Orders for Interactome::reorder. Hubs first, or reverse Cuthill-McKee, which places neighbors close together.
+enum class NodeOrder {
+    degree, reverse_cuthill_mckee
+};
+
+struct Reordering;
+
 // Network (or graph with vertices and edges) containint all entities (genes, proteins, proteoforms and small molecules)
 // in Reactome with all its interactions.
 
@@ -18,33 +31,86 @@
 // Each entity type has a range of indexes [x, y], where all possible indexes between x and y inclusive are entities
 // of the said type.
 // First are the genes, then proteins, then proteoforms, then small molecules.
+//
+// The adjacency is stored in compressed sparse row (CSR) form: the neighbors of node i are
+// neighbors[offsets[i]], ..., neighbors[offsets[i + 1] - 1], sorted ascending.
+// The CSR arrays are rebuilt in bulk by addInteractions, readEdges and compact, and are read-only otherwise.
+// All arrays may live inside a mapped snapshot file (see writeSnapshot and readSnapshot).
+// Small updates go to a delta log of patched neighbor lists, merged into the CSR arrays by compact.
 class Interactome {
 
-    std::map<std::string, int> node_indexes;
-    std::vector<std::string> node_names;
-    std::vector<std::set<int>> adj_list;
-//
-//    std::vector<int> start_indexes;
-//    std::vector<int> end_indexes;
-//
-//    void readRanges(std::string_view file_interactions);
-//
-//    void readEdges(std::string_view file_indexes);
-//
-//    std::map<int, std::vector<int>> genes_to_proteins;
-//
-//    std::map<int, std::vector<int>> proteins_to_proteoform;
-//
-//    void readGenesToProteins(std::string_view file_proteins_to_genes);
-//
-//    void readProteinsToProteoforms(std::string_view file_proteins_to_proteoforms);
+    NodeNameTable node_names;
+    FrozenArray<char> is_node;      // Indexes below getNumVertices() may be unused in a sparse interactome
+    FrozenArray<int> offsets;       // Size is number of indexes + 1
+    FrozenArray<int> neighbors;     // Concatenated sorted neighbor lists
+
+    std::vector<int> start_indexes; // First index of each Level
+    std::vector<int> end_indexes;   // Last index of each Level
+
+    // Since the Levels are contiguous index ranges in order, each sorted neighbor list is split in one
+    // sub-range per Level. For node i, level_splits[3 * i + k] is the position in neighbors where its
+    // neighbors of Level k + 1 start. Empty until the type ranges are read.
+    FrozenArray<int> level_splits;
+
+    // Delta log: the updated sorted neighbor list of every node touched by the insertions and removals since the
+    // last compaction. These rows take precedence over the CSR arrays.
+    std::unordered_map<int, std::vector<int>> delta_log;
+    long long delta_degree = 0;     // Change in the sum of degrees recorded in the delta log
+
+    [[nodiscard]] std::span<const int> row(int node) const;
+
+    std::vector<int> &patchedRow(int node);
+
+    std::vector<int> applyDelta(std::unordered_map<int, std::vector<int>> &changes, bool insert);
+
+    void addNodes(const std::vector<int> &indexes);
+
+    void updateLevelSplits();
+
+    void checkInTypeRanges(int index) const;
+
+    void mergeInteractions(const std::vector<std::span<const std::pair<int, int>>> &chunks);
+
+    // Hierarchy of the accessioned entities, in both directions. Empty until the mapping files are read.
+    LevelMapping genes_to_proteins;
+    LevelMapping proteins_to_genes;
+    LevelMapping proteins_to_proteoforms;
+    LevelMapping proteoforms_to_proteins;
+
+    [[nodiscard]] LevelMapping readLevelMapping(std::istream &s, Level source_level, Level target_level) const;
+
+    [[nodiscard]] const LevelMapping &getMapping(Level source_level, Level target_level) const;
 
 public:
 
     Interactome();
 
+    explicit Interactome(std::vector<std::pair<int, int>> &interactions);
+
+    // Merges the interactions into the adjacency and rebuilds the CSR arrays in a single pass.
+    // Self loops are ignored and repeated interactions are stored once.
     void addInteractions(std::vector<std::pair<int, int>> &interactions);
 
+    // The insert and remove calls record their changes in the delta log, without rebuilding the CSR arrays,
+    // and return the sorted nodes whose neighbors or existence changed.
+    std::vector<int> insertInteractions(const std::vector<std::pair<int, int>> &interactions);
+
+    std::vector<int> removeInteractions(const std::vector<std::pair<int, int>> &interactions);
+
+    std::vector<int> insertNodes(const std::vector<int> &nodes);
+
+    // Also removes all the interactions of the nodes. Their names are kept in case they are inserted again.
+    std::vector<int> removeNodes(const std::vector<int> &nodes);
+
+    // Merges the delta log into the CSR arrays.
+    void compact();
+
+    [[nodiscard]] bool hasPendingChanges() const { return !delta_log.empty(); }
+
+    // Reads a file with one interaction per line, as two node indexes separated by blanks, like interactome_edges.tsv.
+    // The file is mapped and parsed in newline aligned chunks on all cores, then merged as in addInteractions.
+    void readEdges(std::string_view file_edges);
+
     std::vector<int> getNodes() const;
 
     [[nodiscard]] std::string getNodeName(int node) const;
@@ -52,54 +118,116 @@ public:
 //    Interactome(std::string_view file_vertices, std::string_view file_interactions, std::string_view file_ranges,
 //                std::string_view file_proteins_to_genes, std::string_view file_proteins_to_proteoforms);
 //
-//    int index(std::string_view name);
-//
 
-//
-//    Level get_type(int index);
-//
-//    Level get_type(std::string_view name);
-//
-//    bool isGene(int index);
-//
-//    bool isProtein(int index);
-//
-//    bool isProteoform(int index);
-//
-//    bool isSimpleEntity(int index);
-//
-//    std::vector<int> getProteins(int gene_index);
-//
-//    std::vector<int> getProteoforms(int protein_index);
-//
-//    std::set<int> getNeighbors(int index);
-//
-//    std::set<int> getSimpleEntityNeighbors(int index);
-//
-//    std::set<int> getProteinNeighbors(int index);
-//
-//    std::set<int> getProteoformNeighbors(int index);
-//
-//    std::vector<std::pair<int, int>> getInteractions(std::vector<int> indexes);
-//
-//    int getNumVertices();
-//
-//    int getStartIndexGenes();
-//    int getEndIndexGenes();
-//    int getStartIndexProteins();
-//    int getEndIndexProteins();
-//    int getStartIndexProteoforms();
-//    int getEndIndexProteoforms();
+    // Read "protein gene" and "protein proteoform" name pairs, one per line, like the files
+    // mapping_proteins_to_genes.tsv and mapping_proteins_to_proteoforms.tsv. Require the names and type ranges.
+    void readGenesToProteins(std::istream &s);
+
+    void readProteinsToProteoforms(std::istream &s);
+
+    // Returns a view of the proteins of a gene or of a proteoform.
+    [[nodiscard]] std::span<const int> getProteins(int node) const;
+
+    [[nodiscard]] std::span<const int> getGenes(int protein) const;
+
+    [[nodiscard]] std::span<const int> getProteoforms(int protein) const;
+
+    // Sets in target_set the nodes of the target level mapped from the nodes in source_set, for adjacent levels
+    // among genes, proteins and proteoforms. The bitsets are indexed by position in their level range, as the
+    // accessioned entity vertices of a Module, and must already have the size of the range.
+    void project(const base::dynamic_bitset<> &source_set, Level source_level,
+                 base::dynamic_bitset<> &target_set, Level target_level) const;
 
     void addNode(int index);
 
-    [[nodiscard]] std::vector<int> getInteractors(int node) const;
+    // Returns a view of the sorted neighbors of the node, valid until the next call that modifies the interactome.
+    [[nodiscard]] std::span<const int> getInteractors(int node) const;
+
+    // Returns the interactions between the vertices of the set, which is a bitset over all the vertex indexes.
+    // Each interaction is listed once, as a pair with the smaller index first, sorted.
+    [[nodiscard]] std::vector<std::pair<int, int>> getInteractions(const base::dynamic_bitset<> &vertices) const;
+
+    // Returns the interactions of each vertex set, as above, extracting the sets in parallel.
+    [[nodiscard]] std::vector<std::vector<std::pair<int, int>>> getInteractions(const vb &vertex_sets) const;
+
+    // Number of vertex indexes, which is one more than the largest node index.
+    [[nodiscard]] int getNumVertices() const;
+
+    [[nodiscard]] int getNumInteractions() const;
 
     [[nodiscard]] bool hasNode(int node) const;
     [[nodiscard]] bool hasNode(std::string_view name) const;
 
+    // Returns the index of the node with that name, or -1 if there is none. Does not allocate.
+    [[nodiscard]] int index(std::string_view name) const;
+
+    // Reads "index name" pairs and loads all the names into the name table at once.
     void readNodeNames(std::istream &s);
+
+    // Reads the first and last index of each Level, one "start end" pair per line,
+    // in the order genes, proteins, proteoforms, SimpleEntity.
+    void readTypeRanges(std::istream &s);
+
+    [[nodiscard]] int getStartIndex(Level level) const;
+
+    [[nodiscard]] int getEndIndex(Level level) const;
+
+    // The type queries require the type ranges.
+    [[nodiscard]] Level getType(int index) const;
+
+    [[nodiscard]] Level getType(std::string_view name) const;
+
+    [[nodiscard]] bool isGene(int index) const;
+
+    [[nodiscard]] bool isProtein(int index) const;
+
+    [[nodiscard]] bool isProteoform(int index) const;
+
+    [[nodiscard]] bool isSimpleEntity(int index) const;
+
+    // Returns a view of the sorted neighbors of the node that belong to the level, in constant time.
+    [[nodiscard]] std::span<const int> getInteractors(int node, Level level) const;
+
+    [[nodiscard]] std::span<const int> getGeneNeighbors(int node) const { return getInteractors(node, genes); }
+
+    [[nodiscard]] std::span<const int> getProteinNeighbors(int node) const { return getInteractors(node, proteins); }
+
+    [[nodiscard]] std::span<const int> getProteoformNeighbors(int node) const {
+        return getInteractors(node, proteoforms);
+    }
+
+    [[nodiscard]] std::span<const int> getSimpleEntityNeighbors(int node) const {
+        return getInteractors(node, SimpleEntity);
+    }
+
+    // Returns a copy with the node indexes permuted for memory locality, along with the permutation.
+    // Each Level keeps its index range, so the nodes only move within their range, and nodes come before unused
+    // indexes. The names and the level mappings are carried to the new indexes.
+    [[nodiscard]] Reordering reorder(NodeOrder order) const;
+
+    // Heap bytes of each member. Arrays mapped from a snapshot count as zero.
+    [[nodiscard]] memory::MemoryReport getMemoryReport() const;
+
+    // Writes the interactome to a versioned binary snapshot file.
+    void writeSnapshot(std::string_view path) const;
+
+    // Maps a snapshot written by writeSnapshot and uses its arrays in place, without parsing or copying them.
+    // The mapping is shared with copies of the returned interactome and released with the last of them.
+    static Interactome readSnapshot(std::string_view path);
 };
 
 
+struct Reordering {
+    Interactome interactome;
+    std::vector<int> forward;   // New index of each old index
+    std::vector<int> inverse;   // Old index of each new index
+};
+
+// Moves the nodes of the set to their new indexes. Bit i of the set stands for node start + i, so the bitsets
+// over a level range, like the vertices of a Module, are permuted with start = getStartIndex(level).
+base::dynamic_bitset<> permuteSet(const base::dynamic_bitset<> &set, const std::vector<int> &forward, int start = 0);
+
+// Returns the indexes of the vertex sets that contain any of the nodes, for example those touched by an update.
+std::vector<int> getSetsWithNodes(const vb &vertex_sets, const std::vector<int> &nodes);
+
 #endif //PROTEOFORMNETWORKS_INTERACTOME_HPP
@@ -128,4 +128,9 @@ vs createIntToStr(std::string_view path_file, bool has_header, int selected_colu
     return index_to_entities;
 }
 
-
+memory::MemoryReport Bimap_str_int::getMemoryReport() const {
+    memory::MemoryReport report("Bimap_str_int");
+    report.add("stoi", memory::heapBytes(stoi));
+    report.add("itos", memory::heapBytes(itos));
+    return report;
+}
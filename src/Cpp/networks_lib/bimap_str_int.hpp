@@ -7,6 +7,7 @@
 #include <cstring>
 #include <set>
 #include "types.hpp"
+#include "memory_usage.hpp"
 #include <iostream>
 
 std::string rtrim(std::string &s);
@@ -45,6 +46,8 @@ public:
 
     std::string name(const int index) const { return itos[index]; };
 
+    memory::MemoryReport getMemoryReport() const;
+
 };
 
 #endif // !BIMAP_HPP_
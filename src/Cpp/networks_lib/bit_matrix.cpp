@@ -0,0 +1,46 @@
+#include "bit_matrix.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    constexpr std::size_t BLOCKS_PER_LINE = BitMatrix::ALIGNMENT / sizeof(BitMatrix::block_type);
+}
+
+BitMatrix::BitMatrix(std::size_t num_rows, std::size_t num_columns)
+        : num_rows(num_rows), num_columns(num_columns) {
+    std::size_t blocks_per_row = (num_columns + base::bit_size<block_type>() - 1) / base::bit_size<block_type>();
+    stride = (blocks_per_row + BLOCKS_PER_LINE - 1) / BLOCKS_PER_LINE * BLOCKS_PER_LINE;
+    if (num_rows * stride == 0)
+        return;
+    blocks.reset(static_cast<block_type *>(::operator new[](num_rows * stride * sizeof(block_type),
+                                                            std::align_val_t{ALIGNMENT})));
+    std::fill(blocks.get(), blocks.get() + num_rows * stride, block_type(0));
+}
+
+BitMatrix::BitMatrix(const vb &sets) : BitMatrix(sets.size(), sets.empty() ? 0 : sets.front().size()) {
+    for (auto I = 0u; I < sets.size(); I++) {
+        if (sets[I].size() != num_columns)
+            throw std::invalid_argument("Provided sets over different numbers of entities.");
+        std::copy(sets[I].block_begin(), sets[I].block_end(), blocks.get() + I * stride);
+    }
+}
+
+BitMatrix::BitMatrix(const BitMatrix &other) : BitMatrix(other.num_rows, other.num_columns) {
+    if (blocks)
+        std::copy(other.blocks.get(), other.blocks.get() + num_rows * stride, blocks.get());
+}
+
+BitMatrix &BitMatrix::operator=(BitMatrix other) noexcept {
+    num_rows = other.num_rows;
+    num_columns = other.num_columns;
+    stride = other.stride;
+    blocks = std::move(other.blocks);
+    return *this;
+}
+
+base::dynamic_bitset<> BitMatrix::getBitset(std::size_t row) const {
+    base::dynamic_bitset<> result(num_columns);
+    std::copy(getRowBlocks(row), getRowBlocks(row) + result.blocks(), result.block_begin());
+    return result;
+}
@@ -0,0 +1,72 @@
+#ifndef PROTEOFORMNETWORKS_BIT_MATRIX_HPP
+#define PROTEOFORMNETWORKS_BIT_MATRIX_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include "bitset.h"
+#include "types.hpp"
+
+// Collection of sets over the same entities stored as the rows of a single bit matrix, instead of one heap
+// allocation per bitset as in vb. The rows are contiguous with a stride padded to a multiple of ALIGNMENT bytes,
+// and the matrix starts at an ALIGNMENT boundary, so every row starts at a cache line and fills whole SIMD words.
+// The padding bits after the last column are always unset.
+class BitMatrix {
+public:
+    using block_type = base::dynamic_bitset<>::block_type;
+    using row_type = base::adapted_bitset<block_type>;
+    using const_row_type = base::const_adapted_bitset<block_type>;
+
+    static constexpr std::size_t ALIGNMENT = 64;
+
+private:
+    struct AlignedDelete {
+        void operator()(block_type *blocks) const { ::operator delete[](blocks, std::align_val_t{ALIGNMENT}); }
+    };
+
+    std::size_t num_rows = 0;
+    std::size_t num_columns = 0;
+    std::size_t stride = 0;         // Blocks per row
+    std::unique_ptr<block_type[], AlignedDelete> blocks;
+
+public:
+
+    BitMatrix() = default;
+
+    // Matrix with all bits unset.
+    BitMatrix(std::size_t num_rows, std::size_t num_columns);
+
+    // Copies the sets into the rows. The sets must have the same size, which becomes the number of columns.
+    explicit BitMatrix(const vb &sets);
+
+    BitMatrix(const BitMatrix &other);
+
+    BitMatrix(BitMatrix &&other) noexcept = default;
+
+    BitMatrix &operator=(BitMatrix other) noexcept;
+
+    [[nodiscard]] std::size_t getNumRows() const { return num_rows; }
+
+    [[nodiscard]] std::size_t getNumColumns() const { return num_columns; }
+
+    [[nodiscard]] std::size_t getStride() const { return stride; }
+
+    // Views of a row as a bitset of getStride() blocks, supporting the bitset_base_ operations. The view has the
+    // padding bits at the end, so bits at getNumColumns() and after must not be set through it.
+    [[nodiscard]] row_type getRow(std::size_t row) {
+        return {blocks.get() + row * stride, blocks.get() + (row + 1) * stride};
+    }
+
+    [[nodiscard]] const_row_type getRow(std::size_t row) const {
+        return {blocks.get() + row * stride, blocks.get() + (row + 1) * stride};
+    }
+
+    [[nodiscard]] const block_type *getRowBlocks(std::size_t row) const { return blocks.get() + row * stride; }
+
+    // Copy of a row as a set of getNumColumns() bits.
+    [[nodiscard]] base::dynamic_bitset<> getBitset(std::size_t row) const;
+
+    [[nodiscard]] std::size_t heapBytes() const { return num_rows * stride * sizeof(block_type); }
+};
+
+#endif //PROTEOFORMNETWORKS_BIT_MATRIX_HPP
@@ -0,0 +1,67 @@
+#ifndef PROTEOFORMNETWORKS_FROZEN_ARRAY_HPP
+#define PROTEOFORMNETWORKS_FROZEN_ARRAY_HPP
+
+#include <memory>
+#include <span>
+#include <vector>
+#include "mapped_file.hpp"
+
+// Read-only array that either owns its elements or views them inside a mapped file.
+// The mapped file is kept alive while any array points into it, so copies of a mapped array are cheap.
+template<typename T>
+class FrozenArray {
+    std::vector<T> storage;
+    std::shared_ptr<const MappedFile> mapping;
+    std::span<const T> elements;
+
+public:
+
+    FrozenArray() = default;
+
+    explicit FrozenArray(std::vector<T> values) : storage(std::move(values)), elements(storage) {}
+
+    FrozenArray(std::shared_ptr<const MappedFile> mapping, std::span<const T> elements)
+            : mapping(std::move(mapping)), elements(elements) {}
+
+    FrozenArray(const FrozenArray &other)
+            : storage(other.storage), mapping(other.mapping),
+              elements(other.mapping ? other.elements : std::span<const T>(storage)) {}
+
+    FrozenArray(FrozenArray &&other) noexcept
+            : storage(std::move(other.storage)), mapping(std::move(other.mapping)),
+              elements(mapping ? other.elements : std::span<const T>(storage)) {
+        other.elements = {};
+    }
+
+    FrozenArray &operator=(FrozenArray other) noexcept {
+        storage = std::move(other.storage);
+        mapping = std::move(other.mapping);
+        elements = mapping ? other.elements : std::span<const T>(storage);
+        return *this;
+    }
+
+    [[nodiscard]] std::span<const T> view() const { return elements; }
+
+    [[nodiscard]] std::size_t size() const { return elements.size(); }
+
+    [[nodiscard]] bool empty() const { return elements.empty(); }
+
+    [[nodiscard]] const T *data() const { return elements.data(); }
+
+    [[nodiscard]] const T &operator[](std::size_t i) const { return elements[i]; }
+
+    [[nodiscard]] const T &back() const { return elements.back(); }
+
+    [[nodiscard]] auto begin() const { return elements.begin(); }
+
+    [[nodiscard]] auto end() const { return elements.end(); }
+
+    [[nodiscard]] bool isMapped() const { return mapping != nullptr; }
+
+    // Mapped elements live in the page cache instead of the heap.
+    [[nodiscard]] std::size_t heapBytes() const { return storage.capacity() * sizeof(T); }
+
+    [[nodiscard]] std::vector<T> toVector() const { return std::vector<T>(elements.begin(), elements.end()); }
+};
+
+#endif //PROTEOFORMNETWORKS_FROZEN_ARRAY_HPP
@@ -0,0 +1,15 @@
+#ifndef PROTEOFORMNETWORKS_HASHING_HPP
+#define PROTEOFORMNETWORKS_HASHING_HPP
+
+#include <cstdint>
+
+// SplitMix64 finalizer, a fast mixing function with good avalanche behavior. Used for the MinHash functions and
+// the content hashes of the modules.
+inline std::uint64_t splitMix64(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+#endif //PROTEOFORMNETWORKS_HASHING_HPP
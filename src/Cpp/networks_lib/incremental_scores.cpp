@@ -0,0 +1,113 @@
+#include "incremental_scores.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "hashing.hpp"
+#include "pair_buffers.hpp"
+#include "score_policies.hpp"
+
+namespace {
+    template<typename Score>
+    void patchScores(pair_map<double> &scores, const vb &vertex_sets, const std::vector<int> &changed_modules,
+                     const Score &score_function, const int min_module_size, const int max_module_size,
+                     unsigned num_threads) {
+        if (changed_modules.empty())
+            return;
+
+        // Modules at or beyond the number of sets were removed
+        const int num_sets = vertex_sets.size();
+        int num_indexes = num_sets;
+        for (int module : changed_modules) {
+            if (module < 0)
+                throw std::out_of_range("Provided invalid module index: " + std::to_string(module));
+            num_indexes = std::max(num_indexes, module + 1);
+        }
+        std::vector<char> is_changed(num_indexes, false);
+        for (int module : changed_modules)
+            is_changed[module] = true;
+
+        // Only the keys of the changed modules are looked up, not the whole map
+        for (int module = 0; module < num_indexes; module++) {
+            if (!is_changed[module])
+                continue;
+            for (int other = 0; other < num_indexes; other++)
+                if (other != module && !(is_changed[other] && other < module))
+                    scores.erase({std::min(module, other), std::max(module, other)});
+        }
+
+        std::vector<char> is_selected(num_sets);
+        for (int I = 0; I < num_sets; I++) {
+            long long size = vertex_sets[I].count();
+            is_selected[I] = min_module_size <= size && size <= max_module_size;
+        }
+        std::vector<int> modules;
+        for (int I = 0; I < num_sets; I++)
+            if (is_changed[I] && is_selected[I])
+                modules.push_back(I);
+
+        // Each pair of two changed modules is scored by the task of the first one
+        std::vector<pair_buffer<double>> buffers(modules.size());
+        parallelFor(modules.size(), [&](std::size_t task) {
+            int module = modules[task];
+            for (int other = 0; other < num_sets; other++) {
+                if (other == module || !is_selected[other] || (is_changed[other] && other < module))
+                    continue;
+                double score = score_function(vertex_sets[module], vertex_sets[other]);
+                if (score > 0)
+                    buffers[task].emplace_back(std::make_pair(std::min(module, other), std::max(module, other)),
+                                               score);
+            }
+        }, num_threads);
+
+        for (const auto &buffer : buffers)
+            scores.insert(buffer.begin(), buffer.end());
+    }
+}
+
+std::uint64_t getContentHash(const base::dynamic_bitset<> &set) {
+    std::uint64_t hash = splitMix64(set.size());
+    for (auto block = set.block_begin(); block != set.block_end(); block++)
+        hash = splitMix64(hash ^ *block);
+    return hash;
+}
+
+std::vector<std::uint64_t> getContentHashes(const vb &vertex_sets) {
+    std::vector<std::uint64_t> hashes(vertex_sets.size());
+    std::transform(vertex_sets.begin(), vertex_sets.end(), hashes.begin(), getContentHash);
+    return hashes;
+}
+
+std::vector<int> getChangedModules(const std::vector<std::uint64_t> &old_hashes, const vb &vertex_sets) {
+    std::vector<int> changed;
+    for (auto I = 0u; I < std::max(vertex_sets.size(), old_hashes.size()); I++)
+        if (I >= old_hashes.size() || I >= vertex_sets.size() || getContentHash(vertex_sets[I]) != old_hashes[I])
+            changed.push_back(I);
+    return changed;
+}
+
+std::vector<int> getChangedModules(const vb &old_vertex_sets, const vb &vertex_sets) {
+    std::vector<int> changed;
+    for (auto I = 0u; I < std::max(vertex_sets.size(), old_vertex_sets.size()); I++)
+        if (I >= old_vertex_sets.size() || I >= vertex_sets.size()
+            || vertex_sets[I].size() != old_vertex_sets[I].size() || !(vertex_sets[I] == old_vertex_sets[I]))
+            changed.push_back(I);
+    return changed;
+}
+
+void updateScores(pair_map<double> &scores, const vb &vertex_sets, const std::vector<int> &changed_modules,
+                  std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> score_function,
+                  const int min_module_size, const int max_module_size, unsigned num_threads) {
+    patchScores(scores, vertex_sets, changed_modules, score_function, min_module_size, max_module_size,
+                num_threads);
+}
+
+void updateScores(pair_map<double> &scores, const vb &vertex_sets, const std::vector<int> &changed_modules,
+                  ScoreType type, const int min_module_size, const int max_module_size, unsigned num_threads) {
+    visitScoreType(type, [&](auto policy) {
+        patchScores(scores, vertex_sets, changed_modules,
+                    [](const base::dynamic_bitset<> &set1, const base::dynamic_bitset<> &set2) {
+                        return decltype(policy)::get(getOverlapCounts(set1, set2));
+                    }, min_module_size, max_module_size, num_threads);
+    });
+}
@@ -0,0 +1,38 @@
+#ifndef PROTEOFORMNETWORKS_INCREMENTAL_SCORES_HPP
+#define PROTEOFORMNETWORKS_INCREMENTAL_SCORES_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "types.hpp"
+#include "overlap_types.hpp"
+#include "overlap_counts.hpp"
+#include "parallel.hpp"
+
+// Hash of the size and members of a set, to detect the modules that changed between two runs without keeping
+// the old sets. Equal sets have equal hashes.
+std::uint64_t getContentHash(const base::dynamic_bitset<> &set);
+
+std::vector<std::uint64_t> getContentHashes(const vb &vertex_sets);
+
+// Indexes of the sets whose hash differs from the old hash, including the sets added beyond the old ones and the
+// indexes of the sets removed from the end, sorted.
+std::vector<int> getChangedModules(const std::vector<std::uint64_t> &old_hashes, const vb &vertex_sets);
+
+std::vector<int> getChangedModules(const vb &old_vertex_sets, const vb &vertex_sets);
+
+// Patches the scores of a previous getScores run with the same score and module sizes, after some modules changed.
+// Removes the pairs of the changed modules, then scores the changed modules against all the modules within the
+// module sizes in parallel. Like getScores, keeps only the pairs with a score greater than 0. Removed modules, at or
+// beyond the current number of sets, must be listed as changed, as getChangedModules does.
+// The cost is one pass over the modules to check their sizes, plus the changed modules times the number of modules
+// to erase and rescore their pairs. The pairs of the other modules are not visited.
+void updateScores(pair_map<double> &scores, const vb &vertex_sets, const std::vector<int> &changed_modules,
+                  std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> score_function,
+                  const int min_module_size, const int max_module_size, unsigned num_threads = getNumThreads());
+
+void updateScores(pair_map<double> &scores, const vb &vertex_sets, const std::vector<int> &changed_modules,
+                  ScoreType type, const int min_module_size, const int max_module_size,
+                  unsigned num_threads = getNumThreads());
+
+#endif //PROTEOFORMNETWORKS_INCREMENTAL_SCORES_HPP
@@ -0,0 +1,98 @@
+#include "interface_sizes.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+    constexpr std::size_t PAIRS_PER_TASK = 64;
+
+    bool contains(const base::dynamic_bitset<> &set, int node) {
+        return static_cast<std::size_t>(node) < set.size() && set[node];
+    }
+
+    // Visits the vertices of V1 | V2 from the blocks, without building the union. A node counts in the nodes
+    // interface once it has a neighbor that puts it there, and each edge is counted from its smaller end.
+    template<typename Neighbors>
+    InterfaceSizes countInterface(const base::dynamic_bitset<> &V1, const base::dynamic_bitset<> &V2,
+                                  const Neighbors &getNeighbors) {
+        using block = base::dynamic_bitset<>::block_type;
+        InterfaceSizes sizes;
+        const std::size_t num_blocks = std::max(V1.blocks(), V2.blocks());
+        for (std::size_t B = 0; B < num_blocks; B++) {
+            block bits = (B < V1.blocks() ? V1.block_begin()[B] : 0) | (B < V2.blocks() ? V2.block_begin()[B] : 0);
+            for (; bits != 0; bits &= bits - 1) {
+                int node = B * base::bit_size<block>() + std::countr_zero(bits);
+                bool in1 = contains(V1, node), in2 = contains(V2, node);
+                bool is_interface = false;
+                for (int neighbor : getNeighbors(node)) {
+                    bool neighbor_in1 = contains(V1, neighbor), neighbor_in2 = contains(V2, neighbor);
+                    is_interface |= (in1 && in2) || (in1 && neighbor_in2) || (in2 && neighbor_in1);
+                    if (node < neighbor && (neighbor_in1 || neighbor_in2)
+                        && !(in1 && !in2 && neighbor_in1 && !neighbor_in2)
+                        && !(!in1 && in2 && !neighbor_in1 && neighbor_in2))
+                        sizes.edges++;
+                }
+                sizes.nodes += is_interface;
+            }
+        }
+        return sizes;
+    }
+}
+
+CsrAdjacency::CsrAdjacency(const vusi &adjacency) : offsets(adjacency.size() + 1, 0) {
+    std::vector<std::vector<int>> rows(adjacency.size());
+    for (int I = 0; I < static_cast<int>(adjacency.size()); I++) {
+        for (int neighbor : adjacency[I]) {
+            if (neighbor == I)
+                continue;
+            if (neighbor >= static_cast<int>(rows.size()))
+                throw std::out_of_range("Provided adjacency with a neighbor beyond the vertices: "
+                                        + std::to_string(neighbor));
+            rows[I].push_back(neighbor);
+            rows[neighbor].push_back(I);
+        }
+    }
+    for (auto I = 0u; I < rows.size(); I++) {
+        std::sort(rows[I].begin(), rows[I].end());
+        rows[I].erase(std::unique(rows[I].begin(), rows[I].end()), rows[I].end());
+        offsets[I + 1] = offsets[I] + rows[I].size();
+    }
+    neighbors.reserve(offsets.back());
+    for (const auto &row : rows)
+        neighbors.insert(neighbors.end(), row.begin(), row.end());
+}
+
+CsrAdjacency::CsrAdjacency(const Interactome &interactome) : offsets(interactome.getNumVertices() + 1, 0) {
+    for (int I = 0; I < interactome.getNumVertices(); I++) {
+        offsets[I + 1] = offsets[I];
+        if (interactome.hasNode(I)) {
+            auto row = interactome.getInteractors(I);
+            neighbors.insert(neighbors.end(), row.begin(), row.end());
+            offsets[I + 1] += row.size();
+        }
+    }
+}
+
+InterfaceSizes getInterfaceSizes(const base::dynamic_bitset<> &V1, const base::dynamic_bitset<> &V2,
+                                 const CsrAdjacency &adjacency) {
+    return countInterface(V1, V2, [&](int node) { return adjacency.get(node); });
+}
+
+InterfaceSizes getInterfaceSizes(const base::dynamic_bitset<> &V1, const base::dynamic_bitset<> &V2,
+                                 const vusi &adjacency) {
+    static const std::unordered_set<int> no_neighbors;
+    return countInterface(V1, V2, [&](int node) -> const std::unordered_set<int> & {
+        return static_cast<std::size_t>(node) < adjacency.size() ? adjacency[node] : no_neighbors;
+    });
+}
+
+std::vector<InterfaceSizes> getInterfaceSizes(const vb &vertex_sets, const CsrAdjacency &adjacency,
+                                              std::span<const std::pair<int, int>> pairs, unsigned num_threads) {
+    std::vector<InterfaceSizes> result(pairs.size());
+    parallelFor((pairs.size() + PAIRS_PER_TASK - 1) / PAIRS_PER_TASK, [&](std::size_t task) {
+        auto last = std::min(pairs.size(), (task + 1) * PAIRS_PER_TASK);
+        for (auto I = task * PAIRS_PER_TASK; I < last; I++)
+            result[I] = getInterfaceSizes(vertex_sets[pairs[I].first], vertex_sets[pairs[I].second], adjacency);
+    }, num_threads);
+    return result;
+}
@@ -0,0 +1,73 @@
+#ifndef PROTEOFORMNETWORKS_INTERFACE_SIZES_HPP
+#define PROTEOFORMNETWORKS_INTERFACE_SIZES_HPP
+
+#include <span>
+#include <utility>
+#include <vector>
+#include "types.hpp"
+#include "Interactome.hpp"
+#include "pair_storage.hpp"
+#include "parallel.hpp"
+
+// Size of the interface between two modules with vertex sets V1 and V2:
+// - Nodes: the vertices of V1 with a neighbor in V2, the vertices of V2 with a neighbor in V1, and the vertices in
+//   both sets with any neighbor.
+// - Edges: the interactions between vertices of V1 or V2, except those with both ends only in V1 or only in V2.
+struct InterfaceSizes {
+    std::size_t nodes = 0;
+    std::size_t edges = 0;
+
+    bool operator==(const InterfaceSizes &other) const = default;
+};
+
+// Read-only undirected adjacency in CSR form, like the Interactome, with the sorted neighbors of node i in
+// neighbors[offsets[i]], ..., neighbors[offsets[i + 1] - 1].
+class CsrAdjacency {
+    std::vector<int> offsets;
+    std::vector<int> neighbors;
+
+public:
+
+    CsrAdjacency() = default;
+
+    // Every interaction is added in both directions.
+    explicit CsrAdjacency(const vusi &adjacency);
+
+    // Copies the adjacency of the interactome, including the changes in its delta log.
+    explicit CsrAdjacency(const Interactome &interactome);
+
+    [[nodiscard]] int getNumVertices() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    // Vertices without an entry have no neighbors.
+    [[nodiscard]] std::span<const int> get(int node) const {
+        if (node >= getNumVertices())
+            return {};
+        return {neighbors.data() + offsets[node], static_cast<std::size_t>(offsets[node + 1] - offsets[node])};
+    }
+};
+
+// Computes both interface sizes in one pass over the set bits of V1 | V2 and their neighbors, testing the
+// membership of the neighbors on the bitsets.
+InterfaceSizes getInterfaceSizes(const base::dynamic_bitset<> &V1, const base::dynamic_bitset<> &V2,
+                                 const CsrAdjacency &adjacency);
+
+// As above, reading the neighbors from an adjacency list, which must be symmetric.
+InterfaceSizes getInterfaceSizes(const base::dynamic_bitset<> &V1, const base::dynamic_bitset<> &V2,
+                                 const vusi &adjacency);
+
+// Interface sizes of the requested pairs of vertex sets, in the same order, computed in parallel.
+std::vector<InterfaceSizes> getInterfaceSizes(const vb &vertex_sets, const CsrAdjacency &adjacency,
+                                              std::span<const std::pair<int, int>> pairs,
+                                              unsigned num_threads = getNumThreads());
+
+// Interface sizes of the pairs of a list, like the overlapping pairs of getScores.
+template<typename T>
+PairList<InterfaceSizes> getInterfaceSizes(const vb &vertex_sets, const CsrAdjacency &adjacency,
+                                           const PairList<T> &pairs, unsigned num_threads = getNumThreads()) {
+    std::vector<std::pair<int, int>> requested(pairs.size());
+    for (auto I = 0u; I < pairs.size(); I++)
+        requested[I] = pairs.getPair(I);
+    return {pairs, getInterfaceSizes(vertex_sets, adjacency, requested, num_threads)};
+}
+
+#endif //PROTEOFORMNETWORKS_INTERFACE_SIZES_HPP
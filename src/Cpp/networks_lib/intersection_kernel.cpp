@@ -0,0 +1,184 @@
+#include "intersection_kernel.hpp"
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PROTEOFORMNETWORKS_X86_KERNELS
+#include <immintrin.h>
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f,avx512vpopcntdq")))
+#endif
+
+namespace {
+    using block = base::dynamic_bitset<>::block_type;
+
+    constexpr std::size_t LINE_BLOCKS = 64 / sizeof(block);
+
+    // Rows of each tile in a group, whose partial counts stay in registers
+    constexpr std::size_t GROUP_A = 2;
+    constexpr std::size_t GROUP_B = 4;
+
+    struct ScalarKernel {
+        template<std::size_t RA, std::size_t RB>
+        static void count(const block *const *a, const block *const *b, std::size_t num_blocks,
+                          std::uint32_t *counts, std::size_t counts_stride) {
+            std::uint64_t sums[RA][RB] = {};
+            for (std::size_t w = 0; w < num_blocks; w += sizeof(std::uint64_t) / sizeof(block)) {
+                std::uint64_t words_a[RA];
+                for (std::size_t I = 0; I < RA; I++)
+                    std::memcpy(&words_a[I], a[I] + w, sizeof(std::uint64_t));
+                for (std::size_t J = 0; J < RB; J++) {
+                    std::uint64_t word_b;
+                    std::memcpy(&word_b, b[J] + w, sizeof(std::uint64_t));
+                    for (std::size_t I = 0; I < RA; I++)
+                        sums[I][J] += std::popcount(words_a[I] & word_b);
+                }
+            }
+            for (std::size_t I = 0; I < RA; I++)
+                for (std::size_t J = 0; J < RB; J++)
+                    counts[I * counts_stride + J] = sums[I][J];
+        }
+    };
+
+#ifdef PROTEOFORMNETWORKS_X86_KERNELS
+    struct Avx2Kernel {
+        // Counts of the bits of each byte from a table of the counts of each nibble, summed in 64 bit lanes
+        TARGET_AVX2 static __m256i popcount(__m256i v) {
+            const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i low_nibbles = _mm256_set1_epi8(0x0f);
+            __m256i low = _mm256_and_si256(v, low_nibbles);
+            __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibbles);
+            __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(table, low), _mm256_shuffle_epi8(table, high));
+            return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+        }
+
+        template<std::size_t RA, std::size_t RB>
+        TARGET_AVX2 static void count(const block *const *a, const block *const *b, std::size_t num_blocks,
+                                      std::uint32_t *counts, std::size_t counts_stride) {
+            __m256i sums[RA][RB];
+            for (std::size_t I = 0; I < RA; I++)
+                for (std::size_t J = 0; J < RB; J++)
+                    sums[I][J] = _mm256_setzero_si256();
+            for (std::size_t w = 0; w < num_blocks; w += sizeof(__m256i) / sizeof(block)) {
+                __m256i vectors_a[RA];
+                for (std::size_t I = 0; I < RA; I++)
+                    vectors_a[I] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a[I] + w));
+                for (std::size_t J = 0; J < RB; J++) {
+                    __m256i vector_b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b[J] + w));
+                    for (std::size_t I = 0; I < RA; I++)
+                        sums[I][J] = _mm256_add_epi64(sums[I][J], popcount(_mm256_and_si256(vectors_a[I], vector_b)));
+                }
+            }
+            for (std::size_t I = 0; I < RA; I++) {
+                for (std::size_t J = 0; J < RB; J++) {
+                    alignas(32) std::uint64_t lanes[4];
+                    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sums[I][J]);
+                    counts[I * counts_stride + J] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+                }
+            }
+        }
+    };
+
+    struct Avx512Kernel {
+        template<std::size_t RA, std::size_t RB>
+        TARGET_AVX512 static void count(const block *const *a, const block *const *b, std::size_t num_blocks,
+                                        std::uint32_t *counts, std::size_t counts_stride) {
+            __m512i sums[RA][RB];
+            for (std::size_t I = 0; I < RA; I++)
+                for (std::size_t J = 0; J < RB; J++)
+                    sums[I][J] = _mm512_setzero_si512();
+            for (std::size_t w = 0; w < num_blocks; w += sizeof(__m512i) / sizeof(block)) {
+                __m512i vectors_a[RA];
+                for (std::size_t I = 0; I < RA; I++)
+                    vectors_a[I] = _mm512_loadu_si512(a[I] + w);
+                for (std::size_t J = 0; J < RB; J++) {
+                    __m512i vector_b = _mm512_loadu_si512(b[J] + w);
+                    for (std::size_t I = 0; I < RA; I++)
+                        sums[I][J] = _mm512_add_epi64(sums[I][J],
+                                                      _mm512_popcnt_epi64(_mm512_and_si512(vectors_a[I], vector_b)));
+                }
+            }
+            // Summed through memory, since _mm512_reduce_add_epi64 reads undefined lanes in GCC 12
+            for (std::size_t I = 0; I < RA; I++) {
+                for (std::size_t J = 0; J < RB; J++) {
+                    alignas(64) std::uint64_t lanes[8];
+                    _mm512_store_si512(lanes, sums[I][J]);
+                    std::uint64_t sum = 0;
+                    for (auto lane : lanes)
+                        sum += lane;
+                    counts[I * counts_stride + J] = sum;
+                }
+            }
+        }
+    };
+#endif
+
+    // Walks the tiles in groups of GROUP_A by GROUP_B rows, and single rows at the edges.
+    template<typename Kernel>
+    void countTiles(std::span<const block *const> rows_a, std::span<const block *const> rows_b,
+                    std::size_t num_blocks, std::uint32_t *counts) {
+        const std::size_t num_b = rows_b.size();
+        std::size_t I = 0;
+        for (; I + GROUP_A <= rows_a.size(); I += GROUP_A) {
+            std::size_t J = 0;
+            for (; J + GROUP_B <= num_b; J += GROUP_B)
+                Kernel::template count<GROUP_A, GROUP_B>(&rows_a[I], &rows_b[J], num_blocks, counts + I * num_b + J,
+                                                         num_b);
+            for (; J < num_b; J++)
+                Kernel::template count<GROUP_A, 1>(&rows_a[I], &rows_b[J], num_blocks, counts + I * num_b + J, num_b);
+        }
+        for (; I < rows_a.size(); I++) {
+            std::size_t J = 0;
+            for (; J + GROUP_B <= num_b; J += GROUP_B)
+                Kernel::template count<1, GROUP_B>(&rows_a[I], &rows_b[J], num_blocks, counts + I * num_b + J, num_b);
+            for (; J < num_b; J++)
+                Kernel::template count<1, 1>(&rows_a[I], &rows_b[J], num_blocks, counts + I * num_b + J, num_b);
+        }
+    }
+}
+
+bool isSupported(PopcountKernel kernel) {
+    switch (kernel) {
+        case PopcountKernel::scalar:
+            return true;
+#ifdef PROTEOFORMNETWORKS_X86_KERNELS
+        case PopcountKernel::avx2:
+            return __builtin_cpu_supports("avx2");
+        case PopcountKernel::avx512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+#endif
+        default:
+            return false;
+    }
+}
+
+PopcountKernel getBestPopcountKernel() {
+    static const PopcountKernel best = isSupported(PopcountKernel::avx512) ? PopcountKernel::avx512
+                                       : isSupported(PopcountKernel::avx2) ? PopcountKernel::avx2
+                                                                          : PopcountKernel::scalar;
+    return best;
+}
+
+void getIntersectionCounts(std::span<const block *const> rows_a, std::span<const block *const> rows_b,
+                           std::size_t num_blocks, std::uint32_t *counts, PopcountKernel kernel) {
+    if (num_blocks % LINE_BLOCKS != 0)
+        throw std::invalid_argument("The rows of the intersection kernel must fill whole cache lines.");
+    if (!isSupported(kernel))
+        throw std::invalid_argument("The processor does not support the requested popcount kernel.");
+
+    switch (kernel) {
+#ifdef PROTEOFORMNETWORKS_X86_KERNELS
+        case PopcountKernel::avx512:
+            countTiles<Avx512Kernel>(rows_a, rows_b, num_blocks, counts);
+            break;
+        case PopcountKernel::avx2:
+            countTiles<Avx2Kernel>(rows_a, rows_b, num_blocks, counts);
+            break;
+#endif
+        default:
+            countTiles<ScalarKernel>(rows_a, rows_b, num_blocks, counts);
+    }
+}
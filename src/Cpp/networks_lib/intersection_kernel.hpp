@@ -0,0 +1,31 @@
+#ifndef PROTEOFORMNETWORKS_INTERSECTION_KERNEL_HPP
+#define PROTEOFORMNETWORKS_INTERSECTION_KERNEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "bitset.h"
+
+// Implementations of the intersection counts kernel. The vector ones are compiled for their instruction set
+// regardless of the build flags, and picked at runtime when the processor supports them.
+enum class PopcountKernel {
+    scalar,     // 64 bit popcount
+    avx2,       // Popcount of the bytes with a nibble lookup table, summed with VPSADBW
+    avx512      // VPOPCNTDQ
+};
+
+// The fastest kernel supported by the processor, detected once with CPUID.
+PopcountKernel getBestPopcountKernel();
+
+[[nodiscard]] bool isSupported(PopcountKernel kernel);
+
+// Sizes of the intersections of a tile of sets against another tile, like a matrix product with popcount:
+// counts[I * rows_b.size() + J] = |rows_a[I] & rows_b[J]|. The rows have num_blocks blocks each, which must fill
+// whole cache lines of 64 bytes, like the rows of a BitMatrix. Each set is loaded once per group of rows of the
+// other tile, keeping the partial counts of the group in registers.
+void getIntersectionCounts(std::span<const base::dynamic_bitset<>::block_type *const> rows_a,
+                           std::span<const base::dynamic_bitset<>::block_type *const> rows_b,
+                           std::size_t num_blocks, std::uint32_t *counts,
+                           PopcountKernel kernel = getBestPopcountKernel());
+
+#endif //PROTEOFORMNETWORKS_INTERSECTION_KERNEL_HPP
@@ -0,0 +1,104 @@
+#include "level_mapping.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+LevelMapping::LevelMapping(int source_start, int num_sources, int target_start, int num_targets,
+                           std::vector<std::pair<int, int>> pairs)
+        : source_start(source_start), target_start(target_start), num_targets(num_targets) {
+    for (const auto &[source, target] : pairs) {
+        if (source < source_start || source >= source_start + num_sources)
+            throw std::out_of_range("Provided mapping from a node out of the source range: " + std::to_string(source));
+        if (target < target_start || target >= target_start + num_targets)
+            throw std::out_of_range("Provided mapping to a node out of the target range: " + std::to_string(target));
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    std::vector<int> new_offsets(num_sources + 1, 0);
+    std::vector<int> new_targets;
+    new_targets.reserve(pairs.size());
+    for (const auto &[source, target] : pairs) {
+        new_offsets[source - source_start + 1]++;
+        new_targets.push_back(target);
+    }
+    for (int I = 0; I < num_sources; I++)
+        new_offsets[I + 1] += new_offsets[I];
+
+    offsets = FrozenArray<int>(std::move(new_offsets));
+    targets = FrozenArray<int>(std::move(new_targets));
+}
+
+LevelMapping::LevelMapping(int source_start, int target_start, int num_targets, FrozenArray<int> offsets,
+                           FrozenArray<int> targets)
+        : source_start(source_start), target_start(target_start), num_targets(num_targets),
+          offsets(std::move(offsets)), targets(std::move(targets)) {
+    if (!this->offsets.empty() && static_cast<std::size_t>(this->offsets.back()) != this->targets.size())
+        throw std::invalid_argument("Provided inconsistent level mapping arrays.");
+}
+
+std::span<const int> LevelMapping::get(int source) const {
+    if (source < source_start || source >= source_start + getNumSources())
+        throw std::out_of_range("Provided node out of the source range of the mapping: " + std::to_string(source));
+    int position = source - source_start;
+    return targets.view().subspan(offsets[position], offsets[position + 1] - offsets[position]);
+}
+
+// Counting sort of the pairs by target, which keeps the sources of each target sorted.
+LevelMapping LevelMapping::inverse() const {
+    const int num_sources = getNumSources();
+    LevelMapping result;
+    result.source_start = target_start;
+    result.target_start = source_start;
+    result.num_targets = num_sources;
+
+    std::vector<int> new_offsets(num_targets + 1, 0);
+    for (int target : targets)
+        new_offsets[target - target_start + 1]++;
+    for (int I = 0; I < num_targets; I++)
+        new_offsets[I + 1] += new_offsets[I];
+
+    std::vector<int> new_targets(targets.size());
+    std::vector<int> positions(new_offsets.begin(), new_offsets.end() - 1);
+    for (int I = 0; I < num_sources; I++)
+        for (int J = offsets[I]; J < offsets[I + 1]; J++)
+            new_targets[positions[targets[J] - target_start]++] = source_start + I;
+
+    result.offsets = FrozenArray<int>(std::move(new_offsets));
+    result.targets = FrozenArray<int>(std::move(new_targets));
+    return result;
+}
+
+LevelMapping LevelMapping::permute(const std::vector<int> &forward) const {
+    if (empty())
+        return *this;
+    auto newIndex = [&](int node) {
+        return static_cast<std::size_t>(node) < forward.size() ? forward[node] : node;
+    };
+    std::vector<std::pair<int, int>> pairs;
+    pairs.reserve(targets.size());
+    for (int I = 0; I < getNumSources(); I++)
+        for (int J = offsets[I]; J < offsets[I + 1]; J++)
+            pairs.emplace_back(newIndex(source_start + I), newIndex(targets[J]));
+    return LevelMapping(source_start, getNumSources(), target_start, num_targets, std::move(pairs));
+}
+
+void LevelMapping::project(const base::dynamic_bitset<> &source_set, base::dynamic_bitset<> &target_set) const {
+    if (source_set.size() != static_cast<std::size_t>(getNumSources())
+        || target_set.size() != static_cast<std::size_t>(num_targets))
+        throw std::invalid_argument("Provided bitsets with sizes different from the mapped level ranges.");
+
+    std::fill(target_set.block_begin(), target_set.block_end(), 0);
+    source_set.visit_set([&](auto position) {
+        for (int J = offsets[position]; J < offsets[position + 1]; J++)
+            target_set[targets[J] - target_start] = true;
+    });
+}
+
+memory::MemoryReport LevelMapping::getMemoryReport(std::string name) const {
+    memory::MemoryReport report(std::move(name));
+    report.add("offsets", offsets.heapBytes());
+    report.add("targets", targets.heapBytes());
+    return report;
+}
@@ -0,0 +1,60 @@
+#ifndef PROTEOFORMNETWORKS_LEVEL_MAPPING_HPP
+#define PROTEOFORMNETWORKS_LEVEL_MAPPING_HPP
+
+#include <span>
+#include <utility>
+#include <vector>
+#include "bitset.h"
+#include "frozen_array.hpp"
+#include "memory_usage.hpp"
+
+// Many to many mapping from the nodes of one Level to the nodes of another, like genes to proteins.
+// Since each Level is a contiguous index range, the mapping is stored in CSR form indexed by the position of the
+// source node in its range: the targets of source node start + i are targets[offsets[i]], ..., targets[offsets[i + 1] - 1],
+// sorted ascending.
+class LevelMapping {
+    int source_start = 0;
+    int target_start = 0;
+    int num_targets = 0;
+    FrozenArray<int> offsets;   // Size is number of source nodes + 1
+    FrozenArray<int> targets;   // Node indexes
+
+public:
+
+    LevelMapping() = default;
+
+    // Builds the mapping from (source, target) node index pairs. Repeated pairs are stored once.
+    LevelMapping(int source_start, int num_sources, int target_start, int num_targets,
+                 std::vector<std::pair<int, int>> pairs);
+
+    // Uses arrays written by a previous mapping, for example in a snapshot.
+    LevelMapping(int source_start, int target_start, int num_targets, FrozenArray<int> offsets, FrozenArray<int> targets);
+
+    [[nodiscard]] bool empty() const { return offsets.empty(); }
+
+    [[nodiscard]] int getNumSources() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    [[nodiscard]] int getNumTargets() const { return num_targets; }
+
+    // Returns a view of the sorted targets of the source node.
+    [[nodiscard]] std::span<const int> get(int source) const;
+
+    // Returns the mapping in the opposite direction, like proteins to genes.
+    [[nodiscard]] LevelMapping inverse() const;
+
+    // Returns the mapping between the new indexes of the nodes, given the new index of each node. Indexes beyond
+    // the permutation are kept. The permutation must keep the level ranges in place.
+    [[nodiscard]] LevelMapping permute(const std::vector<int> &forward) const;
+
+    // Sets in target_set exactly the targets of the nodes in source_set. Both bitsets are indexed by position in
+    // their Level range and must already have the size of the range, so no memory is allocated.
+    void project(const base::dynamic_bitset<> &source_set, base::dynamic_bitset<> &target_set) const;
+
+    [[nodiscard]] memory::MemoryReport getMemoryReport(std::string name) const;
+
+    [[nodiscard]] const FrozenArray<int> &getOffsets() const { return offsets; }
+
+    [[nodiscard]] const FrozenArray<int> &getTargets() const { return targets; }
+};
+
+#endif //PROTEOFORMNETWORKS_LEVEL_MAPPING_HPP
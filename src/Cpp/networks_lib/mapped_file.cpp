@@ -0,0 +1,87 @@
+#include "mapped_file.hpp"
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(std::string_view path) {
+    std::string file_name(path);
+    file_handle = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        file_handle = nullptr;
+        throw std::runtime_error("Cannot open file to map: " + file_name);
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size)) {
+        CloseHandle(file_handle);
+        throw std::runtime_error("Cannot get the size of the file to map: " + file_name);
+    }
+    length = static_cast<std::size_t>(file_size.QuadPart);
+    if (length == 0)
+        return;
+
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        CloseHandle(file_handle);
+        throw std::runtime_error("Cannot map file: " + file_name);
+    }
+    bytes = static_cast<const char *>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (bytes == nullptr) {
+        CloseHandle(mapping_handle);
+        CloseHandle(file_handle);
+        throw std::runtime_error("Cannot map file: " + file_name);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (bytes != nullptr)
+        UnmapViewOfFile(bytes);
+    if (mapping_handle != nullptr)
+        CloseHandle(mapping_handle);
+    if (file_handle != nullptr)
+        CloseHandle(file_handle);
+}
+
+#else
+
+MappedFile::MappedFile(std::string_view path) {
+    std::string file_name(path);
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw std::runtime_error("Cannot open file to map: " + file_name);
+
+    struct stat status{};
+    if (fstat(fd, &status) == -1) {
+        close(fd);
+        throw std::runtime_error("Cannot get the size of the file to map: " + file_name);
+    }
+    length = static_cast<std::size_t>(status.st_size);
+    if (length == 0) {
+        close(fd);
+        return;
+    }
+
+    void *address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps its own reference to the file
+    if (address == MAP_FAILED)
+        throw std::runtime_error("Cannot map file: " + file_name);
+    bytes = static_cast<const char *>(address);
+}
+
+MappedFile::~MappedFile() {
+    if (bytes != nullptr)
+        munmap(const_cast<char *>(bytes), length);
+}
+
+#endif
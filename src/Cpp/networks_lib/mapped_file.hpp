@@ -0,0 +1,32 @@
+#ifndef PROTEOFORMNETWORKS_MAPPED_FILE_HPP
+#define PROTEOFORMNETWORKS_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string_view>
+
+// Read-only memory mapping of a whole file.
+// The pages are shared, so processes mapping the same file use the same page cache copy.
+class MappedFile {
+    const char *bytes = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    void *file_handle = nullptr;
+    void *mapping_handle = nullptr;
+#endif
+
+public:
+
+    explicit MappedFile(std::string_view path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    [[nodiscard]] const char *data() const { return bytes; }
+
+    [[nodiscard]] std::size_t size() const { return length; }
+};
+
+#endif //PROTEOFORMNETWORKS_MAPPED_FILE_HPP
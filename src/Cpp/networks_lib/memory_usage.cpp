@@ -0,0 +1,65 @@
+#include "memory_usage.hpp"
+
+#include <algorithm>
+
+namespace memory {
+
+    MemoryReport &MemoryReport::add(std::string member_name, std::size_t member_bytes) {
+        members.emplace_back(std::move(member_name), member_bytes);
+        return *this;
+    }
+
+    MemoryReport &MemoryReport::add(MemoryReport member) {
+        members.push_back(std::move(member));
+        return *this;
+    }
+
+    std::size_t MemoryReport::total() const {
+        std::size_t result = bytes;
+        for (const auto &member : members)
+            result += member.total();
+        return result;
+    }
+
+    namespace {
+        void writeMember(std::ostream &output, const MemoryReport &report, const std::string &prefix) {
+            std::string path = prefix.empty() ? report.name : prefix + "." + report.name;
+            output << path << '\t' << report.total() << '\n';
+            for (const auto &member : report.members)
+                writeMember(output, member, path);
+        }
+    }
+
+    void MemoryReport::write(std::ostream &output) const {
+        output << "member\tbytes\n";
+        writeMember(output, *this, "");
+    }
+
+    void AllocationCounter::allocated(std::size_t n) {
+        allocations++;
+        long long current = bytes += n;
+        long long previous_peak = peak;
+        while (current > previous_peak && !peak.compare_exchange_weak(previous_peak, current));
+    }
+
+    void AllocationCounter::deallocated(std::size_t n) {
+        bytes -= n;
+    }
+
+    AllocationCounter &getDefaultCounter() {
+        static AllocationCounter counter;
+        return counter;
+    }
+
+    MemoryReport getMemoryReport(const AllocationCounter &counter, std::string name) {
+        return MemoryReport(std::move(name), static_cast<std::size_t>(std::max(0LL, counter.bytes.load())));
+    }
+
+    MemoryReport getMemoryReport(const std::vector<base::dynamic_bitset<>> &sets, std::string name) {
+        MemoryReport report(std::move(name), sets.capacity() * sizeof(base::dynamic_bitset<>));
+        std::size_t blocks = 0;
+        for (const auto &set : sets)
+            blocks += heapBytes(set);
+        return report.add("blocks", blocks);
+    }
+}
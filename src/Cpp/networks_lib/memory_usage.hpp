@@ -0,0 +1,222 @@
+#ifndef PROTEOFORMNETWORKS_MEMORY_USAGE_HPP
+#define PROTEOFORMNETWORKS_MEMORY_USAGE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <new>
+#include <ostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "bitset.h"
+#include "frozen_array.hpp"
+
+// Accounting of the heap memory used by the data structures, to size jobs and compare layouts.
+// The heapBytes functions compute the bytes from the container sizes. For the node based standard containers
+// they follow the libstdc++ node layout, so they are estimates. CountingAllocator measures the real bytes.
+namespace memory {
+
+    // Heap bytes of a data structure, broken down by member.
+    struct MemoryReport {
+        std::string name;
+        std::size_t bytes = 0;                  // Of this member alone, without the members below it
+        std::vector<MemoryReport> members;
+
+        explicit MemoryReport(std::string name, std::size_t bytes = 0) : name(std::move(name)), bytes(bytes) {}
+
+        MemoryReport &add(std::string member_name, std::size_t member_bytes);
+
+        MemoryReport &add(MemoryReport member);
+
+        [[nodiscard]] std::size_t total() const;
+
+        // Writes a tab separated table with a header, and one line with the path and total bytes of each member,
+        // like "Interactome.node_names.chars	1024".
+        void write(std::ostream &output) const;
+    };
+
+    // Bytes currently allocated and the peak, shared by all the allocators that point to the counter.
+    struct AllocationCounter {
+        std::atomic<long long> bytes{0};
+        std::atomic<long long> peak{0};
+        std::atomic<long long> allocations{0};
+
+        void allocated(std::size_t n);
+
+        void deallocated(std::size_t n);
+    };
+
+    // Global counter used by default constructed CountingAllocators.
+    AllocationCounter &getDefaultCounter();
+
+    // Standard allocator that records its allocations in a counter, to measure containers like
+    // std::vector<int, CountingAllocator<int>> or base::dynamic_bitset<unsigned, CountingAllocator<unsigned>>.
+    // Opt-in: the library containers use the standard allocator, and tests or benchmarks build the same layouts
+    // with this one to check the heapBytes estimates, or to measure the bytes saved by a change of layout.
+    template<typename T>
+    class CountingAllocator {
+        AllocationCounter *counter;
+
+        template<typename U> friend
+        class CountingAllocator;
+
+    public:
+        using value_type = T;
+
+        CountingAllocator() noexcept: counter(&getDefaultCounter()) {}
+
+        explicit CountingAllocator(AllocationCounter &counter) noexcept: counter(&counter) {}
+
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U> &other) noexcept : counter(other.counter) {}
+
+        T *allocate(std::size_t n) {
+            auto p = std::allocator<T>().allocate(n);
+            counter->allocated(n * sizeof(T));
+            return p;
+        }
+
+        void deallocate(T *p, std::size_t n) noexcept {
+            std::allocator<T>().deallocate(p, n);
+            counter->deallocated(n * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator==(const CountingAllocator<U> &other) const noexcept { return counter == other.counter; }
+    };
+
+    // All the overloads are declared first, so that nested containers find each other.
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    std::size_t heapBytes(const T &);
+
+    std::size_t heapBytes(const std::string &s);
+
+    template<typename A, typename B>
+    std::size_t heapBytes(const std::pair<A, B> &p);
+
+    template<typename T, typename A>
+    std::size_t heapBytes(const std::vector<T, A> &v);
+
+    template<typename T>
+    std::size_t heapBytes(const FrozenArray<T> &a);
+
+    template<typename T, typename A>
+    std::size_t heapBytes(const base::dynamic_bitset<T, A> &b);
+
+    template<typename K, typename C, typename A>
+    std::size_t heapBytes(const std::set<K, C, A> &s);
+
+    template<typename K, typename V, typename C, typename A>
+    std::size_t heapBytes(const std::map<K, V, C, A> &m);
+
+    template<typename K, typename H, typename E, typename A>
+    std::size_t heapBytes(const std::unordered_set<K, H, E, A> &s);
+
+    template<typename K, typename V, typename H, typename E, typename A>
+    std::size_t heapBytes(const std::unordered_map<K, V, H, E, A> &m);
+
+    template<typename K, typename V, typename H, typename E, typename A>
+    std::size_t heapBytes(const std::unordered_multimap<K, V, H, E, A> &m);
+
+    namespace detail {
+        // Red black tree node: color, parent, left and right, then the value
+        template<typename V>
+        constexpr std::size_t TREE_NODE_BYTES = 4 * sizeof(void *) + sizeof(V);
+
+        // Hash table node: next pointer, the value and, for non trivial keys, the cached hash code
+        template<typename K, typename V>
+        constexpr std::size_t HASH_NODE_BYTES =
+                sizeof(void *) + sizeof(V) + (std::is_arithmetic_v<K> ? 0 : sizeof(std::size_t));
+
+        template<typename Container>
+        std::size_t elementsHeapBytes(const Container &container) {
+            std::size_t total = 0;
+            for (const auto &element : container)
+                total += heapBytes(element);
+            return total;
+        }
+
+        template<typename K, typename Table>
+        std::size_t hashTableBytes(const Table &table) {
+            return table.bucket_count() * sizeof(void *)
+                   + table.size() * HASH_NODE_BYTES<K, typename Table::value_type> + elementsHeapBytes(table);
+        }
+    }
+
+    template<typename T>
+    requires std::is_trivially_copyable_v<T>
+    std::size_t heapBytes(const T &) {
+        return 0;
+    }
+
+    inline std::size_t heapBytes(const std::string &s) {
+        // Short strings are stored inside the object
+        auto object = reinterpret_cast<const char *>(&s);
+        bool is_local = s.data() >= object && s.data() < object + sizeof(s);
+        return is_local ? 0 : s.capacity() + 1;
+    }
+
+    template<typename A, typename B>
+    std::size_t heapBytes(const std::pair<A, B> &p) {
+        return heapBytes(p.first) + heapBytes(p.second);
+    }
+
+    template<typename T, typename A>
+    std::size_t heapBytes(const std::vector<T, A> &v) {
+        return v.capacity() * sizeof(T) + detail::elementsHeapBytes(v);
+    }
+
+    template<typename T>
+    std::size_t heapBytes(const FrozenArray<T> &a) {
+        return a.heapBytes();
+    }
+
+    template<typename T, typename A>
+    std::size_t heapBytes(const base::dynamic_bitset<T, A> &b) {
+        // The bit count and the blocks, allocated in units of the bit count size
+        if (b.size() == 0)
+            return 0;
+        constexpr std::size_t unit = sizeof(std::size_t);
+        return (unit + b.blocks() * sizeof(T) + unit - 1) / unit * unit;
+    }
+
+    template<typename K, typename C, typename A>
+    std::size_t heapBytes(const std::set<K, C, A> &s) {
+        return s.size() * detail::TREE_NODE_BYTES<K> + detail::elementsHeapBytes(s);
+    }
+
+    template<typename K, typename V, typename C, typename A>
+    std::size_t heapBytes(const std::map<K, V, C, A> &m) {
+        return m.size() * detail::TREE_NODE_BYTES<std::pair<const K, V>> + detail::elementsHeapBytes(m);
+    }
+
+    template<typename K, typename H, typename E, typename A>
+    std::size_t heapBytes(const std::unordered_set<K, H, E, A> &s) {
+        return detail::hashTableBytes<K>(s);
+    }
+
+    template<typename K, typename V, typename H, typename E, typename A>
+    std::size_t heapBytes(const std::unordered_map<K, V, H, E, A> &m) {
+        return detail::hashTableBytes<K>(m);
+    }
+
+    template<typename K, typename V, typename H, typename E, typename A>
+    std::size_t heapBytes(const std::unordered_multimap<K, V, H, E, A> &m) {
+        return detail::hashTableBytes<K>(m);
+    }
+
+    // Report of the bytes currently allocated through the counter, to compare with an estimated report.
+    MemoryReport getMemoryReport(const AllocationCounter &counter, std::string name);
+
+    // Report of a collection of bitsets, like the vertex sets of the modules.
+    MemoryReport getMemoryReport(const std::vector<base::dynamic_bitset<>> &sets, std::string name = "vb");
+}
+
+#endif //PROTEOFORMNETWORKS_MEMORY_USAGE_HPP
@@ -0,0 +1,140 @@
+#include "minhash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include "hashing.hpp"
+#include "overlap_counts.hpp"
+#include "pair_buffers.hpp"
+
+namespace {
+    constexpr std::size_t SETS_PER_TASK = 256;
+
+    std::uint64_t hashBand(std::span<const std::uint32_t> rows) {
+        std::uint64_t hash = rows.size();
+        for (auto row : rows)
+            hash = splitMix64(hash ^ row);
+        return hash;
+    }
+}
+
+MinHashSignatures::MinHashSignatures(const vb &vertex_sets, int num_hashes, std::uint64_t seed,
+                                     unsigned num_threads) : num_hashes(num_hashes) {
+    if (num_hashes <= 0)
+        throw std::invalid_argument("The number of hashes must be positive.");
+
+    std::vector<std::uint64_t> seeds(num_hashes);
+    for (int I = 0; I < num_hashes; I++)
+        seeds[I] = splitMix64(seed + I);
+
+    values.assign(vertex_sets.size() * num_hashes, std::numeric_limits<std::uint32_t>::max());
+    const std::size_t num_tasks = (vertex_sets.size() + SETS_PER_TASK - 1) / SETS_PER_TASK;
+    parallelFor(num_tasks, [&](std::size_t task) {
+        auto last = std::min(vertex_sets.size(), (task + 1) * SETS_PER_TASK);
+        for (auto I = task * SETS_PER_TASK; I < last; I++) {
+            std::uint32_t *signature = values.data() + I * num_hashes;
+            vertex_sets[I].visit_set([&](auto entity) {
+                for (int J = 0; J < num_hashes; J++)
+                    signature[J] = std::min(signature[J], static_cast<std::uint32_t>(splitMix64(seeds[J] ^ entity)));
+            });
+        }
+    }, num_threads);
+}
+
+double MinHashSignatures::estimateJaccardSimilarity(int set1, int set2) const {
+    auto signature1 = get(set1), signature2 = get(set2);
+    int agreements = 0;
+    for (int I = 0; I < num_hashes; I++)
+        agreements += signature1[I] == signature2[I];
+    return static_cast<double>(agreements) / num_hashes;
+}
+
+double getLshRecall(double jaccard_similarity, const LshParameters &parameters) {
+    return 1.0 - std::pow(1.0 - std::pow(jaccard_similarity, parameters.rows_per_band), parameters.num_bands);
+}
+
+ApproximateScores getApproximateJaccardScores(const vb &vertex_sets, double threshold,
+                                              const LshParameters &parameters, unsigned num_threads) {
+    if (parameters.num_bands <= 0 || parameters.rows_per_band <= 0)
+        throw std::invalid_argument("The numbers of bands and rows per band must be positive.");
+    for (const auto &set : vertex_sets)
+        if (set.size() != vertex_sets.front().size())
+            throw std::invalid_argument("Provided sets over different numbers of entities.");
+
+    MinHashSignatures signatures(vertex_sets, parameters.num_bands * parameters.rows_per_band, parameters.seed,
+                                 num_threads);
+
+    // Candidates of each band: the pairs of sets in the same bucket, found by sorting the band hashes. The bands are
+    // hashed in groups of one band per thread, and the candidates of each group are merged into the sorted unique
+    // candidates right away, so repeated pairs are kept once instead of once per band.
+    ApproximateScores result;
+    std::vector<std::pair<int, int>> candidates, merged;
+    std::vector<int> skipped_sets;
+    const std::size_t num_bands = parameters.num_bands, group_size = std::max(1u, num_threads);
+    for (std::size_t first_band = 0; first_band < num_bands; first_band += group_size) {
+        const std::size_t num_group_bands = std::min(group_size, num_bands - first_band);
+        std::vector<std::vector<std::pair<int, int>>> band_candidates(num_group_bands);
+        std::vector<std::vector<int>> band_skipped(num_group_bands);
+        parallelFor(num_group_bands, [&](std::size_t task) {
+            const std::size_t band = first_band + task;
+            std::vector<std::pair<std::uint64_t, int>> buckets(vertex_sets.size());
+            for (auto I = 0u; I < vertex_sets.size(); I++)
+                buckets[I] = {hashBand(signatures.get(I).subspan(band * parameters.rows_per_band,
+                                                                 parameters.rows_per_band)), I};
+            std::sort(buckets.begin(), buckets.end());
+            for (auto first = buckets.begin(); first != buckets.end();) {
+                auto last = std::find_if(first, buckets.end(), [&](const auto &entry) { return entry.first != first->first; });
+                if (static_cast<std::size_t>(last - first) > parameters.max_bucket_size) {
+                    for (auto it = first; it != last; it++)
+                        band_skipped[task].push_back(it->second);
+                } else {
+                    for (auto it1 = first; it1 != last; it1++)
+                        for (auto it2 = it1 + 1; it2 != last; it2++)
+                            band_candidates[task].emplace_back(it1->second, it2->second);
+                }
+                first = last;
+            }
+            std::sort(band_candidates[task].begin(), band_candidates[task].end());
+        }, num_threads);
+
+        for (auto &band : band_candidates) {
+            merged.clear();
+            merged.reserve(candidates.size() + band.size());
+            std::merge(candidates.begin(), candidates.end(), band.begin(), band.end(), std::back_inserter(merged));
+            merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+            std::swap(candidates, merged);
+            band = {};
+        }
+        for (const auto &band : band_skipped)
+            skipped_sets.insert(skipped_sets.end(), band.begin(), band.end());
+        std::sort(skipped_sets.begin(), skipped_sets.end());
+        skipped_sets.erase(std::unique(skipped_sets.begin(), skipped_sets.end()), skipped_sets.end());
+    }
+    merged = {};
+
+    result.num_candidates = candidates.size();
+    result.skipped_sets = std::move(skipped_sets);
+    result.min_recall = getLshRecall(threshold, parameters);
+
+    const std::size_t num_tasks = (candidates.size() + SETS_PER_TASK - 1) / SETS_PER_TASK;
+    std::vector<pair_buffer<double>> buffers(num_tasks);
+    parallelFor(num_tasks, [&](std::size_t task) {
+        auto last = std::min(candidates.size(), (task + 1) * SETS_PER_TASK);
+        for (auto I = task * SETS_PER_TASK; I < last; I++) {
+            auto [set1, set2] = candidates[I];
+            auto score = getOverlapCounts(vertex_sets[set1], vertex_sets[set2]).getJaccardSimilarity();
+            if (score > 0 && score >= threshold)
+                buffers[task].emplace_back(candidates[I], score);
+        }
+    }, num_threads);
+
+    result.scores = mergeBuffers(buffers);
+    double estimated_total = 0.0;
+    for (const auto &[pair, score] : result.scores)
+        estimated_total += 1.0 / getLshRecall(score, parameters);
+    if (estimated_total > 0)
+        result.estimated_recall = result.scores.size() / estimated_total;
+    return result;
+}
@@ -0,0 +1,74 @@
+#ifndef PROTEOFORMNETWORKS_MINHASH_HPP
+#define PROTEOFORMNETWORKS_MINHASH_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "types.hpp"
+#include "overlap_types.hpp"
+#include "parallel.hpp"
+
+// MinHash signatures of a group of vertex sets: for each of num_hashes hash functions of the entities, the minimum
+// hash over the entities of the set. Two signatures agree in each position with probability equal to the Jaccard
+// similarity of the sets. Empty sets get the maximum value everywhere, so they agree only with each other.
+// The signatures are stored one after the other in a single array.
+class MinHashSignatures {
+    int num_hashes = 0;
+    std::vector<std::uint32_t> values;
+
+public:
+
+    MinHashSignatures() = default;
+
+    MinHashSignatures(const vb &vertex_sets, int num_hashes, std::uint64_t seed = 1,
+                      unsigned num_threads = getNumThreads());
+
+    [[nodiscard]] int getNumHashes() const { return num_hashes; }
+
+    [[nodiscard]] std::size_t size() const { return num_hashes ? values.size() / num_hashes : 0; }
+
+    [[nodiscard]] std::span<const std::uint32_t> get(int set) const {
+        return {values.data() + static_cast<std::size_t>(set) * num_hashes, static_cast<std::size_t>(num_hashes)};
+    }
+
+    // Fraction of positions where the signatures agree.
+    [[nodiscard]] double estimateJaccardSimilarity(int set1, int set2) const;
+};
+
+// Banding of the signatures for locality sensitive hashing: the signature is cut in num_bands bands of
+// rows_per_band hashes, and two sets become candidates when they agree in all the rows of any band.
+// More bands find more of the similar pairs, at the cost of more candidates; more rows per band discard more of
+// the dissimilar ones. Buckets with more than max_bucket_size sets, like those of many empty or identical sets, which
+// share a bucket in every band, are skipped, since they would propose a number of pairs quadratic in their size.
+struct LshParameters {
+    int num_bands = 20;
+    int rows_per_band = 5;
+    std::uint64_t seed = 1;
+    std::size_t max_bucket_size = 1000;
+};
+
+// Probability that a pair with that Jaccard similarity becomes a candidate: 1 - (1 - s^rows)^bands.
+double getLshRecall(double jaccard_similarity, const LshParameters &parameters);
+
+struct ApproximateScores {
+    pair_map<double> scores;
+    std::size_t num_candidates = 0;
+    // Estimate of the fraction of all the pairs over the threshold that were found. Each pair found with similarity
+    // s stands for 1 / getLshRecall(s) pairs, so the estimate is the number found over the sum of those weights.
+    double estimated_recall = 1.0;
+    // Probability of finding a pair exactly at the threshold, the lowest for any pair over it.
+    double min_recall = 1.0;
+    // Sets in a bucket skipped for exceeding max_bucket_size in any band, sorted. Their pairs were proposed only
+    // by the other bands, so the recall estimates do not cover them. To find all their pairs, score them exactly,
+    // for example with getScores on a ModuleSetCollection and a threshold.
+    std::vector<int> skipped_sets;
+};
+
+// Jaccard similarity of the pairs of sets with similarity at least threshold, and greater than 0, for collections
+// too large to score all the pairs. The candidate pairs proposed by the banded signatures are scored exactly, as
+// getJaccardSimilarity, so the scores are exact but some of the pairs may be missing.
+ApproximateScores getApproximateJaccardScores(const vb &vertex_sets, double threshold,
+                                              const LshParameters &parameters = {},
+                                              unsigned num_threads = getNumThreads());
+
+#endif //PROTEOFORMNETWORKS_MINHASH_HPP
@@ -0,0 +1,24 @@
+#include "module_set_collection.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+ModuleSetCollection::ModuleSetCollection(vb sets) : sets(std::move(sets)) {
+    sizes.reserve(this->sets.size());
+    for (const auto &set : this->sets)
+        sizes.push_back(set.count());
+
+    by_size.resize(this->sets.size());
+    std::iota(by_size.begin(), by_size.end(), 0);
+    std::stable_sort(by_size.begin(), by_size.end(), [&](int a, int b) { return sizes[a] < sizes[b]; });
+}
+
+std::span<const int> ModuleSetCollection::getModulesWithSizes(std::size_t min_size, std::size_t max_size) const {
+    auto first = std::partition_point(by_size.begin(), by_size.end(), [&](int module) {
+        return sizes[module] < min_size;
+    });
+    auto last = std::partition_point(first, by_size.end(), [&](int module) {
+        return sizes[module] <= max_size;
+    });
+    return {by_size.data() + (first - by_size.begin()), static_cast<std::size_t>(last - first)};
+}
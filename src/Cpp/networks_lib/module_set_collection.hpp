@@ -0,0 +1,36 @@
+#ifndef PROTEOFORMNETWORKS_MODULE_SET_COLLECTION_HPP
+#define PROTEOFORMNETWORKS_MODULE_SET_COLLECTION_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "types.hpp"
+
+// Vertex sets of a group of modules, with the size of each set counted once and the modules ordered by size.
+// Module indexes are the positions of the sets in the vector given to the constructor.
+class ModuleSetCollection {
+    vb sets;
+    std::vector<std::size_t> sizes;
+    std::vector<int> by_size;       // Module indexes by increasing size, ties by index
+
+public:
+
+    ModuleSetCollection() = default;
+
+    explicit ModuleSetCollection(vb sets);
+
+    [[nodiscard]] int size() const { return sets.size(); }
+
+    [[nodiscard]] const base::dynamic_bitset<> &getSet(int module) const { return sets[module]; }
+
+    [[nodiscard]] const vb &getSets() const { return sets; }
+
+    [[nodiscard]] std::size_t getSize(int module) const { return sizes[module]; }
+
+    [[nodiscard]] std::span<const int> getOrderBySize() const { return by_size; }
+
+    // Returns the modules with min_size <= size <= max_size, by increasing size.
+    [[nodiscard]] std::span<const int> getModulesWithSizes(std::size_t min_size, std::size_t max_size) const;
+};
+
+#endif //PROTEOFORMNETWORKS_MODULE_SET_COLLECTION_HPP
@@ -0,0 +1,109 @@
+#include "node_name_table.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+NodeNameTable::NodeNameTable() : offsets(std::vector<int>(1, 0)) {
+
+}
+
+NodeNameTable::NodeNameTable(const std::vector<std::string> &names) {
+    std::size_t num_names = std::count_if(names.begin(), names.end(), [](const auto &name) { return !name.empty(); });
+    NodeNameTableBuilder builder(names.size(), num_names);
+    for (auto I = 0u; I < names.size(); I++) {
+        if (!names[I].empty() && builder.add(I, names[I]) != -1)
+            throw std::invalid_argument("Provided repeated node name: " + names[I]);
+    }
+    *this = builder.build();
+}
+
+NodeNameTable::NodeNameTable(FrozenArray<int> offsets, FrozenArray<char> chars, FrozenArray<int> slots)
+        : offsets(std::move(offsets)), chars(std::move(chars)), slots(std::move(slots)) {
+
+}
+
+std::string_view NodeNameTable::name(int node) const {
+    return {chars.data() + offsets[node], static_cast<std::size_t>(offsets[node + 1] - offsets[node])};
+}
+
+int NodeNameTable::index(std::string_view name) const {
+    if (slots.empty() || name.empty())
+        return -1;
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t slot = hash(name) & mask; slots[slot] != -1; slot = (slot + 1) & mask) {
+        if (this->name(slots[slot]) == name)
+            return slots[slot];
+    }
+    return -1;
+}
+
+std::vector<std::string> NodeNameTable::toVector() const {
+    std::vector<std::string> names;
+    names.reserve(size());
+    for (int node = 0; node < size(); node++)
+        names.emplace_back(name(node));
+    return names;
+}
+
+std::uint64_t NodeNameTable::hash(std::string_view name) {
+    std::uint64_t result = 14695981039346656037ull;
+    for (char c : name) {
+        result ^= static_cast<unsigned char>(c);
+        result *= 1099511628211ull;
+    }
+    return result;
+}
+
+std::size_t NodeNameTable::numSlots(std::size_t num_names) {
+    std::size_t result = 1;
+    while (result < 2 * num_names)
+        result *= 2;
+    return num_names == 0 ? 0 : result;
+}
+
+memory::MemoryReport NodeNameTable::getMemoryReport() const {
+    memory::MemoryReport report("node_names");
+    report.add("offsets", offsets.heapBytes());
+    report.add("chars", chars.heapBytes());
+    report.add("slots", slots.heapBytes());
+    return report;
+}
+
+NodeNameTableBuilder::NodeNameTableBuilder(int num_nodes, int num_names)
+        : starts(num_nodes, 0), lengths(num_nodes, 0), slots(NodeNameTable::numSlots(num_names), -1) {
+
+}
+
+int NodeNameTableBuilder::add(int node, std::string_view name) {
+    if (name.empty())
+        return -1;
+    if (2 * (num_names + 1) > slots.size())
+        throw std::logic_error("Added more names than the builder was sized for.");
+
+    const std::size_t mask = slots.size() - 1;
+    std::size_t slot = NodeNameTable::hash(name) & mask;
+    for (; slots[slot] != -1; slot = (slot + 1) & mask) {
+        if (this->name(slots[slot]) == name)
+            return slots[slot];
+    }
+
+    starts[node] = chars.size();
+    lengths[node] = name.size();
+    chars.insert(chars.end(), name.begin(), name.end());
+    slots[slot] = node;
+    num_names++;
+    return -1;
+}
+
+// Moves the names to node order, so that the arena only needs one offset per node
+NodeNameTable NodeNameTableBuilder::build() {
+    std::vector<int> offsets(starts.size() + 1, 0);
+    for (auto node = 0u; node < starts.size(); node++)
+        offsets[node + 1] = offsets[node] + lengths[node];
+
+    std::vector<char> ordered_chars(offsets.back());
+    for (auto node = 0u; node < starts.size(); node++)
+        std::copy_n(chars.begin() + starts[node], lengths[node], ordered_chars.begin() + offsets[node]);
+
+    return NodeNameTable(FrozenArray<int>(std::move(offsets)), FrozenArray<char>(std::move(ordered_chars)),
+                         FrozenArray<int>(std::move(slots)));
+}
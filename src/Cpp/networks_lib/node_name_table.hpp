@@ -0,0 +1,84 @@
+#ifndef PROTEOFORMNETWORKS_NODE_NAME_TABLE_HPP
+#define PROTEOFORMNETWORKS_NODE_NAME_TABLE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "frozen_array.hpp"
+#include "memory_usage.hpp"
+
+// Names of the interactome nodes stored in a single character arena.
+// The name of node i is chars[offsets[i]], ..., chars[offsets[i + 1] - 1]. Unnamed nodes have an empty name.
+// Names are found through an open addressing hash index with linear probing, which compares string views
+// against the arena, so lookups do not allocate. The hash does not depend on the process, so the index can be
+// stored in a snapshot.
+class NodeNameTable {
+    FrozenArray<int> offsets;
+    FrozenArray<char> chars;
+    FrozenArray<int> slots;     // Node whose name hashes to each slot, or -1. Size is zero or a power of two.
+
+public:
+
+    NodeNameTable();
+
+    // Names must not be repeated, except for the empty name.
+    explicit NodeNameTable(const std::vector<std::string> &names);
+
+    NodeNameTable(FrozenArray<int> offsets, FrozenArray<char> chars, FrozenArray<int> slots);
+
+    [[nodiscard]] int size() const { return offsets.size() - 1; }
+
+    [[nodiscard]] std::string_view name(int node) const;
+
+    // Returns the node with that name, or -1 if no node has it.
+    [[nodiscard]] int index(std::string_view name) const;
+
+    [[nodiscard]] bool has(std::string_view name) const { return index(name) != -1; }
+
+    [[nodiscard]] std::vector<std::string> toVector() const;
+
+    [[nodiscard]] memory::MemoryReport getMemoryReport() const;
+
+    [[nodiscard]] const FrozenArray<int> &getOffsets() const { return offsets; }
+
+    [[nodiscard]] const FrozenArray<char> &getChars() const { return chars; }
+
+    [[nodiscard]] const FrozenArray<int> &getSlots() const { return slots; }
+
+    // 64 bit FNV-1a hash of the name.
+    static std::uint64_t hash(std::string_view name);
+
+    // Number of hash slots for the number of names, keeping the load factor at most one half.
+    static std::size_t numSlots(std::size_t num_names);
+};
+
+// Fills a NodeNameTable one name at a time, with the nodes in any order.
+// The names are appended to one arena and indexed as they arrive, so adding a name does not allocate
+// besides the arena growth.
+class NodeNameTableBuilder {
+    std::vector<int> starts;
+    std::vector<int> lengths;
+    std::vector<char> chars;
+    std::vector<int> slots;
+    std::size_t num_names = 0;
+
+    [[nodiscard]] std::string_view name(int node) const {
+        return {chars.data() + starts[node], static_cast<std::size_t>(lengths[node])};
+    }
+
+public:
+
+    // The number of names is an upper bound used to size the hash index.
+    NodeNameTableBuilder(int num_nodes, int num_names);
+
+    [[nodiscard]] bool hasName(int node) const { return lengths[node] != 0; }
+
+    // Names the node, which must not have a name yet.
+    // Returns -1, or the node that already has the same name, in which case nothing is added.
+    int add(int node, std::string_view name);
+
+    NodeNameTable build();
+};
+
+#endif //PROTEOFORMNETWORKS_NODE_NAME_TABLE_HPP
@@ -0,0 +1,49 @@
+#include "overlap_counts.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include "simd.h"
+
+namespace {
+    // Widest word for which simd.h picks a native vector when compiled with AVX2, and sequences of
+    // narrower vectors otherwise.
+    constexpr std::size_t WORD_BITS = 256;
+    using word = base::wide_scalar<WORD_BITS>;
+    using block = base::dynamic_bitset<>::block_type;
+    constexpr std::size_t BLOCKS_PER_WORD = WORD_BITS / base::bit_size<block>();
+
+    std::size_t countBlocks(const block *begin, const block *end) {
+        std::size_t result = 0;
+        for (auto it = begin; it != end; it++)
+            result += std::popcount(*it);
+        return result;
+    }
+}
+
+OverlapCounts getOverlapCounts(const base::dynamic_bitset<> &set1, const base::dynamic_bitset<> &set2) {
+    OverlapCounts counts;
+    const block *blocks1 = set1.block_begin(), *blocks2 = set2.block_begin();
+    const std::size_t common_blocks = std::min(set1.blocks(), set2.blocks());
+
+    // The blocks are copied into the words because the bitset storage is not aligned to the vector size
+    std::size_t I = 0;
+    for (; I + BLOCKS_PER_WORD <= common_blocks; I += BLOCKS_PER_WORD) {
+        word a, b;
+        std::memcpy(a.block_begin(), blocks1 + I, sizeof(word));
+        std::memcpy(b.block_begin(), blocks2 + I, sizeof(word));
+        counts.size1 += base::popcount(a);
+        counts.size2 += base::popcount(b);
+        counts.intersection_size += base::popcount(a & b);
+    }
+    for (; I < common_blocks; I++) {
+        counts.size1 += std::popcount(blocks1[I]);
+        counts.size2 += std::popcount(blocks2[I]);
+        counts.intersection_size += std::popcount(blocks1[I] & blocks2[I]);
+    }
+    counts.size1 += countBlocks(blocks1 + common_blocks, set1.block_end());
+    counts.size2 += countBlocks(blocks2 + common_blocks, set2.block_end());
+
+    counts.union_size = counts.size1 + counts.size2 - counts.intersection_size;
+    return counts;
+}
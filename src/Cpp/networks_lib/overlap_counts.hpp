@@ -0,0 +1,48 @@
+#ifndef PROTEOFORMNETWORKS_OVERLAP_COUNTS_HPP
+#define PROTEOFORMNETWORKS_OVERLAP_COUNTS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include "bitset.h"
+
+// The scores of a pair of sets that can be computed from its OverlapCounts.
+enum class ScoreType {
+    jaccard, overlap_coefficient, overlap_size
+};
+
+// Cardinalities of two sets and of their intersection and union.
+struct OverlapCounts {
+    std::size_t size1 = 0;
+    std::size_t size2 = 0;
+    std::size_t intersection_size = 0;
+    std::size_t union_size = 0;
+
+    // Jaccard index: size of the intersection over the size of the union. Two empty sets have similarity 1.
+    [[nodiscard]] double getJaccardSimilarity() const {
+        return union_size == 0 ? 1.0 : static_cast<double>(intersection_size) / union_size;
+    }
+
+    // Overlap coefficient: size of the intersection over the size of the smaller set. It is 1 if a set is empty.
+    [[nodiscard]] double getOverlapSimilarity() const {
+        return size1 == 0 || size2 == 0 ? 1.0 : static_cast<double>(intersection_size) / std::min(size1, size2);
+    }
+
+    [[nodiscard]] double getOverlapSize() const { return intersection_size; }
+
+    [[nodiscard]] double getScore(ScoreType type) const {
+        switch (type) {
+            case ScoreType::jaccard:
+                return getJaccardSimilarity();
+            case ScoreType::overlap_coefficient:
+                return getOverlapSimilarity();
+            default:
+                return getOverlapSize();
+        }
+    }
+};
+
+// Counts the sets in a single pass over their blocks, without building the intersection or union.
+// The blocks are combined in SIMD words of base::wide_scalar. Bits beyond the end of the shorter set count as unset.
+OverlapCounts getOverlapCounts(const base::dynamic_bitset<> &set1, const base::dynamic_bitset<> &set2);
+
+#endif //PROTEOFORMNETWORKS_OVERLAP_COUNTS_HPP
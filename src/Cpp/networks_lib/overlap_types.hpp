@@ -9,7 +9,8 @@ struct hash_pair {
     size_t operator()(const std::pair<T1, T2> &p) const {
         auto hash1 = std::hash<T1>{}(p.first);
         auto hash2 = std::hash<T2>{}(p.second);
-        return hash1 ^ hash2;
+        // Combined as in boost::hash_combine, since a plain xor sends every (i, i) to 0 and collides for swapped pairs
+        return hash1 ^ (hash2 + 0x9e3779b97f4a7c15ULL + (hash1 << 6) + (hash1 >> 2));
     }
 };
 
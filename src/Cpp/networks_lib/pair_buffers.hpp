@@ -0,0 +1,26 @@
+#ifndef PROTEOFORMNETWORKS_PAIR_BUFFERS_HPP
+#define PROTEOFORMNETWORKS_PAIR_BUFFERS_HPP
+
+#include <utility>
+#include <vector>
+#include "overlap_types.hpp"
+
+// Internal to the parallel scoring drivers: each task fills its own buffer of scored pairs, which are merged into a
+// single map once all the tasks finish.
+template<typename T>
+using pair_buffer = std::vector<std::pair<std::pair<int, int>, T>>;
+
+// Merges the buffers of the tasks into a single map, reserved for all the pairs at once.
+template<typename T>
+pair_map<T> mergeBuffers(const std::vector<pair_buffer<T>> &buffers) {
+    std::size_t num_scores = 0;
+    for (const auto &buffer : buffers)
+        num_scores += buffer.size();
+    pair_map<T> result;
+    result.reserve(num_scores);
+    for (const auto &buffer : buffers)
+        result.insert(buffer.begin(), buffer.end());
+    return result;
+}
+
+#endif //PROTEOFORMNETWORKS_PAIR_BUFFERS_HPP
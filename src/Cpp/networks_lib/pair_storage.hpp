@@ -0,0 +1,143 @@
+#ifndef PROTEOFORMNETWORKS_PAIR_STORAGE_HPP
+#define PROTEOFORMNETWORKS_PAIR_STORAGE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "overlap_types.hpp"
+
+// Containers for the scores of pairs of sets, without the heap node per entry and the hashing of pair_map.
+
+// Dense value of every unordered pair of num_sets sets, for the results of all pairs runs. Only the upper triangle
+// without the diagonal is stored, row by row: (0, 1), (0, 2), ..., (0, n - 1), (1, 2), ...
+template<typename T>
+class TriangularMatrix {
+    std::size_t num_sets = 0;
+    std::vector<T> values;
+
+public:
+
+    TriangularMatrix() = default;
+
+    explicit TriangularMatrix(std::size_t num_sets, const T &value = T())
+            : num_sets(num_sets), values(num_sets < 2 ? 0 : num_sets * (num_sets - 1) / 2, value) {}
+
+    [[nodiscard]] std::size_t getNumSets() const { return num_sets; }
+
+    // Number of pairs
+    [[nodiscard]] std::size_t size() const { return values.size(); }
+
+    // Position of the pair in the values, for set1 != set2 in any order.
+    [[nodiscard]] std::size_t getIndex(int set1, int set2) const {
+        std::size_t i = std::min(set1, set2), j = std::max(set1, set2);
+        return i * (2 * num_sets - i - 1) / 2 + (j - i - 1);
+    }
+
+    [[nodiscard]] T &operator()(int set1, int set2) { return values[getIndex(set1, set2)]; }
+
+    [[nodiscard]] const T &operator()(int set1, int set2) const { return values[getIndex(set1, set2)]; }
+
+    // Values of the pairs (set, set + 1), ..., (set, n - 1), contiguous.
+    [[nodiscard]] std::span<T> getRow(int set) {
+        return {values.data() + (set + 1 < static_cast<int>(num_sets) ? getIndex(set, set + 1) : values.size()),
+                num_sets - set - 1};
+    }
+
+    [[nodiscard]] std::span<const T> getRow(int set) const {
+        return {values.data() + (set + 1 < static_cast<int>(num_sets) ? getIndex(set, set + 1) : values.size()),
+                num_sets - set - 1};
+    }
+
+    // Calls f(set1, set2, value) for every pair, in storage order.
+    template<typename F>
+    void forEach(F &&f) const {
+        auto value = values.begin();
+        for (int I1 = 0; I1 < static_cast<int>(num_sets); I1++)
+            for (int I2 = I1 + 1; I2 < static_cast<int>(num_sets); I2++)
+                f(I1, I2, *value++);
+    }
+
+    [[nodiscard]] std::size_t heapBytes() const { return values.capacity() * sizeof(T); }
+
+    bool operator==(const TriangularMatrix &other) const = default;
+};
+
+// Sparse values of some pairs of sets, as a coordinate list sorted by pair, in structure of arrays form: the pairs
+// packed in 64 bit keys, first set in the high half, and the values in a parallel array. Pairs are looked up with a
+// binary search over the keys. The pairs are stored as given, so lookups must use the same order, like the
+// smaller set first of the getScores results.
+template<typename T>
+class PairList {
+    std::vector<std::uint64_t> keys;
+    std::vector<T> values;
+
+    static std::uint64_t getKey(int set1, int set2) {
+        return static_cast<std::uint64_t>(static_cast<std::uint32_t>(set1)) << 32 | static_cast<std::uint32_t>(set2);
+    }
+
+public:
+
+    PairList() = default;
+
+    // Sorts the entries by pair. The pairs must be distinct.
+    explicit PairList(std::vector<std::pair<std::pair<int, int>, T>> entries) {
+        std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+        keys.reserve(entries.size());
+        values.reserve(entries.size());
+        for (auto &[pair, value] : entries) {
+            std::uint64_t key = getKey(pair.first, pair.second);
+            if (!keys.empty() && keys.back() == key)
+                throw std::invalid_argument("Repeated pair in the pair list.");
+            keys.push_back(key);
+            values.push_back(std::move(value));
+        }
+    }
+
+    explicit PairList(const pair_map<T> &scores)
+            : PairList(std::vector<std::pair<std::pair<int, int>, T>>(scores.begin(), scores.end())) {}
+
+    // Same pairs as other, with the values replaced.
+    template<typename U>
+    PairList(const PairList<U> &other, std::vector<T> values) : keys(other.getKeys()), values(std::move(values)) {
+        if (this->values.size() != keys.size())
+            throw std::invalid_argument("The number of values does not match the number of pairs.");
+    }
+
+    [[nodiscard]] std::size_t size() const { return keys.size(); }
+
+    [[nodiscard]] bool empty() const { return keys.empty(); }
+
+    [[nodiscard]] int getFirst(std::size_t position) const { return static_cast<int>(keys[position] >> 32); }
+
+    [[nodiscard]] int getSecond(std::size_t position) const { return static_cast<int>(keys[position] & 0xffffffffu); }
+
+    [[nodiscard]] std::pair<int, int> getPair(std::size_t position) const {
+        return {getFirst(position), getSecond(position)};
+    }
+
+    [[nodiscard]] const T &getValue(std::size_t position) const { return values[position]; }
+
+    [[nodiscard]] const std::vector<std::uint64_t> &getKeys() const { return keys; }
+
+    [[nodiscard]] std::span<const T> getValues() const { return values; }
+
+    // Value of the pair, or nullptr if it is not in the list.
+    [[nodiscard]] const T *find(int set1, int set2) const {
+        std::uint64_t key = getKey(set1, set2);
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        return it != keys.end() && *it == key ? &values[it - keys.begin()] : nullptr;
+    }
+
+    [[nodiscard]] bool contains(int set1, int set2) const { return find(set1, set2) != nullptr; }
+
+    [[nodiscard]] std::size_t heapBytes() const {
+        return keys.capacity() * sizeof(std::uint64_t) + values.capacity() * sizeof(T);
+    }
+
+    bool operator==(const PairList &other) const = default;
+};
+
+#endif //PROTEOFORMNETWORKS_PAIR_STORAGE_HPP
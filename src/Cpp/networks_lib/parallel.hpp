@@ -0,0 +1,132 @@
+#ifndef PROTEOFORMNETWORKS_PARALLEL_HPP
+#define PROTEOFORMNETWORKS_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Number of threads used by the parallel algorithms: one per hardware thread.
+inline unsigned getNumThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+namespace parallel_detail {
+
+    // Set in the pool workers, and in the calling thread while it runs a job, so nested parallelFor calls run serially
+    inline thread_local bool in_parallel_for = false;
+
+    // Worker threads kept alive between calls, so the drivers that call parallelFor many times, like streamScores
+    // once per wave, do not start and join threads each time. Runs one job at a time: the job runs on the calling
+    // thread and on the first num_helpers workers, which are started the first time they are needed.
+    class ThreadPool {
+        std::mutex run_mutex;
+        std::mutex mutex;
+        std::condition_variable job_ready;
+        std::condition_variable job_done;
+        std::vector<std::thread> workers;
+        const std::function<void()> *job = nullptr;
+        std::size_t generation = 0;     // Number of jobs started
+        unsigned num_helpers = 0;       // Workers that take part in the current job
+        unsigned num_running = 0;       // Of those, the ones still running it
+        bool stopping = false;
+
+        void work(unsigned index) {
+            in_parallel_for = true;
+            std::size_t seen_generation = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                job_ready.wait(lock, [&] { return stopping || generation != seen_generation; });
+                if (stopping)
+                    return;
+                seen_generation = generation;
+                if (index >= num_helpers)
+                    continue;
+                const auto *current_job = job;
+                lock.unlock();
+                (*current_job)();
+                lock.lock();
+                if (--num_running == 0)
+                    job_done.notify_one();
+            }
+        }
+
+    public:
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            job_ready.notify_all();
+            for (auto &worker : workers)
+                worker.join();
+        }
+
+        static ThreadPool &get() {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        // The job must not throw.
+        void run(unsigned helpers, const std::function<void()> &f) {
+            std::lock_guard<std::mutex> run_lock(run_mutex);
+            std::unique_lock<std::mutex> lock(mutex);
+            while (workers.size() < helpers)
+                workers.emplace_back(&ThreadPool::work, this, static_cast<unsigned>(workers.size()));
+            job = &f;
+            num_helpers = helpers;
+            num_running = helpers;
+            generation++;
+            lock.unlock();
+            job_ready.notify_all();
+
+            in_parallel_for = true;
+            f();
+            in_parallel_for = false;
+
+            lock.lock();
+            job_done.wait(lock, [&] { return num_running == 0; });
+            job = nullptr;
+        }
+    };
+}
+
+// Runs task(i) for every i in [0, num_tasks), handing out the indexes dynamically to the calling thread and
+// num_threads - 1 threads of a pool kept alive between calls. Calls from inside a task run serially.
+// The first exception thrown by a task is rethrown in the calling thread once all threads finish.
+template<typename F>
+void parallelFor(std::size_t num_tasks, F &&task, unsigned num_threads = getNumThreads()) {
+    num_threads = static_cast<unsigned>(std::min<std::size_t>(num_threads, num_tasks));
+    if (num_threads <= 1 || parallel_detail::in_parallel_for) {
+        for (std::size_t i = 0; i < num_tasks; i++)
+            task(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next_task = 0;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    std::function<void()> worker = [&]() {
+        try {
+            for (auto i = next_task++; i < num_tasks; i = next_task++)
+                task(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error)
+                error = std::current_exception();
+            next_task = num_tasks;
+        }
+    };
+
+    parallel_detail::ThreadPool::get().run(num_threads - 1, worker);
+    if (error)
+        std::rethrow_exception(error);
+}
+
+#endif //PROTEOFORMNETWORKS_PARALLEL_HPP
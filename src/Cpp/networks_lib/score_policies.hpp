@@ -0,0 +1,83 @@
+#ifndef PROTEOFORMNETWORKS_SCORE_POLICIES_HPP
+#define PROTEOFORMNETWORKS_SCORE_POLICIES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include "overlap_counts.hpp"
+
+// Compile-time score policies for the scoring drivers of scores.hpp. Each policy has the value_type of its score
+// and a static get that computes it from the OverlapCounts of a pair, which the drivers inline in their loops.
+// The scalar policies also have the ScoreType they stand for, and an upper bound of the score given only the sizes
+// of the two sets, which does not increase as the sizes move apart.
+
+struct JaccardScore {
+    using value_type = double;
+    static constexpr ScoreType type = ScoreType::jaccard;
+
+    static double get(const OverlapCounts &counts) { return counts.getJaccardSimilarity(); }
+
+    static double getUpperBound(std::size_t size1, std::size_t size2) {
+        auto [smaller, larger] = std::minmax(size1, size2);
+        return larger == 0 ? 1.0 : static_cast<double>(smaller) / larger;
+    }
+};
+
+struct OverlapCoefficientScore {
+    using value_type = double;
+    static constexpr ScoreType type = ScoreType::overlap_coefficient;
+
+    static double get(const OverlapCounts &counts) { return counts.getOverlapSimilarity(); }
+
+    static double getUpperBound(std::size_t, std::size_t) { return 1.0; }
+};
+
+struct OverlapSizeScore {
+    using value_type = double;
+    static constexpr ScoreType type = ScoreType::overlap_size;
+
+    static double get(const OverlapCounts &counts) { return counts.getOverlapSize(); }
+
+    static double getUpperBound(std::size_t size1, std::size_t size2) { return std::min(size1, size2); }
+};
+
+// The shared count, overlap coefficient and Jaccard index of a pair, the columns of the overlap tables.
+struct OverlapScores {
+    std::size_t overlap_size = 0;
+    double overlap_similarity = 0.0;
+    double jaccard_similarity = 0.0;
+
+    bool operator==(const OverlapScores &other) const = default;
+};
+
+// All the scores of OverlapScores from the same counts, in one pass over the two sets.
+struct AllOverlapScores {
+    using value_type = OverlapScores;
+
+    static OverlapScores get(const OverlapCounts &counts) {
+        return {counts.intersection_size, counts.getOverlapSimilarity(), counts.getJaccardSimilarity()};
+    }
+};
+
+// The drivers keep only the pairs with a positive score, or with any positive score.
+inline bool isPositive(double score) {
+    return score > 0;
+}
+
+inline bool isPositive(const OverlapScores &scores) {
+    return scores.overlap_size > 0 || scores.overlap_similarity > 0 || scores.jaccard_similarity > 0;
+}
+
+// Calls f with the policy of the score type, to dispatch a runtime ScoreType to the templated drivers.
+template<typename F>
+decltype(auto) visitScoreType(ScoreType type, F &&f) {
+    switch (type) {
+        case ScoreType::jaccard:
+            return f(JaccardScore{});
+        case ScoreType::overlap_coefficient:
+            return f(OverlapCoefficientScore{});
+        default:
+            return f(OverlapSizeScore{});
+    }
+}
+
+#endif //PROTEOFORMNETWORKS_SCORE_POLICIES_HPP
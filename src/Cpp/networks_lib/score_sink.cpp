@@ -0,0 +1,145 @@
+#include "score_sink.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    constexpr char MAGIC[8] = {'P', 'F', 'N', 'S', 'C', 'O', 'R', 'E'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+    };
+
+    struct Record {
+        std::int32_t module1;
+        std::int32_t module2;
+        std::uint64_t overlap_size;
+        double overlap_similarity;
+        double jaccard_similarity;
+    };
+
+    static_assert(sizeof(Record) == 32, "Score records must have no padding.");
+
+    double getScore(const OverlapScores &scores, ScoreType type) {
+        switch (type) {
+            case ScoreType::jaccard:
+                return scores.jaccard_similarity;
+            case ScoreType::overlap_coefficient:
+                return scores.overlap_similarity;
+            default:
+                return scores.overlap_size;
+        }
+    }
+}
+
+TsvScoreSink::TsvScoreSink(std::ostream &output, const std::vector<std::string> &module_names, Level level,
+                           bool write_header) : output(output), module_names(module_names), level(level) {
+    if (write_header)
+        output << "LEVEL\t" << "MODULE1\t" << "MODULE2\t" << "SHARED_ACCESSIONED_ENTITIES\t" << "OVERLAP_COEFFICIENT\t"
+               << "JACCARD_INDEX\n";
+}
+
+void TsvScoreSink::consume(std::span<const ScoredPair> chunk) {
+    for (const auto &pair : chunk) {
+        output << LEVELS[level] << "\t" << module_names[pair.module1] << "\t" << module_names[pair.module2] << "\t"
+               << pair.scores.overlap_size << "\t" << pair.scores.overlap_similarity << "\t"
+               << pair.scores.jaccard_similarity << "\n";
+    }
+}
+
+void TsvScoreSink::finish() {
+    output.flush();
+    if (!output)
+        throw std::runtime_error("Failed writing the overlap scores table.");
+}
+
+BinaryScoreSink::BinaryScoreSink(std::ostream &output) : output(output) {
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+void BinaryScoreSink::consume(std::span<const ScoredPair> chunk) {
+    std::vector<Record> records;
+    records.reserve(chunk.size());
+    for (const auto &pair : chunk)
+        records.push_back({pair.module1, pair.module2, pair.scores.overlap_size, pair.scores.overlap_similarity,
+                           pair.scores.jaccard_similarity});
+    output.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(Record));
+}
+
+void BinaryScoreSink::finish() {
+    output.flush();
+    if (!output)
+        throw std::runtime_error("Failed writing the binary overlap scores.");
+}
+
+void readScores(std::istream &input, ScoreSink &sink, std::size_t chunk_size) {
+    Header header{};
+    if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        throw std::runtime_error("Score file is too short.");
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::runtime_error("File is not a score file.");
+    if (header.byte_order != BYTE_ORDER_MARK)
+        throw std::runtime_error("Score file was written with a different byte order.");
+    if (header.version != VERSION)
+        throw std::runtime_error("Score file version " + std::to_string(header.version) + " is not supported, "
+                                 + "expected " + std::to_string(VERSION) + ".");
+
+    chunk_size = std::max<std::size_t>(1, chunk_size);
+    std::vector<Record> records(chunk_size);
+    std::vector<ScoredPair> chunk;
+    chunk.reserve(chunk_size);
+    while (input) {
+        input.read(reinterpret_cast<char *>(records.data()), chunk_size * sizeof(Record));
+        auto bytes = static_cast<std::size_t>(input.gcount());
+        if (bytes % sizeof(Record) != 0)
+            throw std::runtime_error("Score file ends in the middle of a record.");
+        chunk.clear();
+        for (auto I = 0u; I < bytes / sizeof(Record); I++)
+            chunk.push_back({records[I].module1, records[I].module2,
+                             {records[I].overlap_size, records[I].overlap_similarity, records[I].jaccard_similarity}});
+        if (!chunk.empty())
+            sink.consume(chunk);
+    }
+    sink.finish();
+}
+
+TopScoresSink::TopScoresSink(std::size_t k, ScoreType type) : k(k), type(type) {
+    heap.reserve(k);
+}
+
+bool TopScoresSink::isBetter(const ScoredPair &pair1, const ScoredPair &pair2) const {
+    double score1 = getScore(pair1.scores, type), score2 = getScore(pair2.scores, type);
+    if (score1 != score2)
+        return score1 > score2;
+    return std::make_pair(pair1.module1, pair1.module2) < std::make_pair(pair2.module1, pair2.module2);
+}
+
+void TopScoresSink::consume(std::span<const ScoredPair> chunk) {
+    auto better = [this](const ScoredPair &pair1, const ScoredPair &pair2) { return isBetter(pair1, pair2); };
+    for (const auto &pair : chunk) {
+        if (heap.size() < k) {
+            heap.push_back(pair);
+            std::push_heap(heap.begin(), heap.end(), better);
+        } else if (k > 0 && isBetter(pair, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = pair;
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+    }
+}
+
+std::vector<ScoredPair> TopScoresSink::getTopScores() const {
+    auto result = heap;
+    std::sort(result.begin(), result.end(),
+              [this](const ScoredPair &pair1, const ScoredPair &pair2) { return isBetter(pair1, pair2); });
+    return result;
+}
@@ -0,0 +1,86 @@
+#ifndef PROTEOFORMNETWORKS_SCORE_SINK_HPP
+#define PROTEOFORMNETWORKS_SCORE_SINK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+#include "types.hpp"
+#include "overlap_counts.hpp"
+#include "score_policies.hpp"
+
+// A pair of modules, by index, with its overlap scores. The row of a streamed overlap table.
+struct ScoredPair {
+    int module1 = 0;
+    int module2 = 0;
+    OverlapScores scores;
+
+    bool operator==(const ScoredPair &other) const = default;
+};
+
+// Consumer of the scores pushed in chunks by streamScores, so the scores of all the pairs are never in memory at
+// once. The chunks arrive one at a time from the calling thread, then finish is called once.
+class ScoreSink {
+public:
+    virtual ~ScoreSink() = default;
+
+    virtual void consume(std::span<const ScoredPair> chunk) = 0;
+
+    virtual void finish() {}
+};
+
+// Writes the pairs as rows of the overlap table of calculateOverlap, like all_pairs.tsv and overlapping_pairs.tsv:
+// LEVEL, MODULE1, MODULE2, SHARED_ACCESSIONED_ENTITIES, OVERLAP_COEFFICIENT, JACCARD_INDEX, with the module names at
+// the indexes of the collection. The header is written on construction, so the sinks of the other levels can
+// append to the same stream without it.
+class TsvScoreSink : public ScoreSink {
+    std::ostream &output;
+    const std::vector<std::string> &module_names;
+    Level level;
+
+public:
+    TsvScoreSink(std::ostream &output, const std::vector<std::string> &module_names, Level level,
+                 bool write_header = true);
+
+    void consume(std::span<const ScoredPair> chunk) override;
+
+    void finish() override;
+};
+
+// Writes the pairs as fixed size binary records after a small header, readable with readScores. Much smaller and
+// faster to parse than the table, for runs that are post-processed by other programs.
+class BinaryScoreSink : public ScoreSink {
+    std::ostream &output;
+
+public:
+    explicit BinaryScoreSink(std::ostream &output);
+
+    void consume(std::span<const ScoredPair> chunk) override;
+
+    void finish() override;
+};
+
+// Pushes the pairs of a file written by BinaryScoreSink to another sink, in chunks of chunk_size pairs.
+// Throws a runtime_error if the stream is not a score file of this version.
+void readScores(std::istream &input, ScoreSink &sink, std::size_t chunk_size = 1 << 16);
+
+// Keeps only the k pairs with the highest score of the type among all the pairs consumed, ties by pair.
+class TopScoresSink : public ScoreSink {
+    std::size_t k;
+    ScoreType type;
+    std::vector<ScoredPair> heap;   // Worst of the kept pairs first
+
+    [[nodiscard]] bool isBetter(const ScoredPair &pair1, const ScoredPair &pair2) const;
+
+public:
+    TopScoresSink(std::size_t k, ScoreType type);
+
+    void consume(std::span<const ScoredPair> chunk) override;
+
+    // The kept pairs by decreasing score.
+    [[nodiscard]] std::vector<ScoredPair> getTopScores() const;
+};
+
+#endif //PROTEOFORMNETWORKS_SCORE_SINK_HPP
@@ -1,4 +1,11 @@
 #include "scores.hpp"
+#include "interface_sizes.hpp"
+#include "intersection_kernel.hpp"
+#include "pair_buffers.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <tuple>
 
 
 using namespace std;
@@ -97,56 +104,512 @@ void writeMeasures(ofstream &report, const ummss &mapping, string_view label1, s
     writeMeasures(report, measures, label1, label2);
 }
 
-double getJaccardSimilarity(base::dynamic_bitset<> set1, base::dynamic_bitset<> set2) {
-    if (set1.count() == 0 && set2.count() == 0) {
-        return 1.0;
-    } else {
-        double intersection_size = (set1 & set2).count();
-        double union_size = (set1 | set2).count();
-        return intersection_size / union_size;
+double getJaccardSimilarity(const base::dynamic_bitset<> &set1, const base::dynamic_bitset<> &set2) {
+    return getOverlapCounts(set1, set2).getJaccardSimilarity();
+}
+
+double getOverlapSimilarity(const base::dynamic_bitset<> &set1, const base::dynamic_bitset<> &set2) {
+    return getOverlapCounts(set1, set2).getOverlapSimilarity();
+}
+
+double getOverlapSize(const base::dynamic_bitset<> &set1, const base::dynamic_bitset<> &set2) {
+    return getOverlapCounts(set1, set2).getOverlapSize();
+}
+
+namespace {
+    // Bytes of the sets on each side of a tile, so that the sets of a tile stay in the L2 cache while it is scored
+    constexpr std::size_t TILE_BYTES = 1 << 17;
+    constexpr std::size_t MIN_TILE_SIDE = 8;
+    constexpr std::size_t MAX_TILE_SIDE = 256;
+
+    // Modules of the size ordered collection scanned by each task of the pruned all pairs scores
+    constexpr std::size_t MODULES_PER_TASK = 16;
+
+    // Pairs rescored by each task of the rescoring of a PairList
+    constexpr std::size_t PAIRS_PER_TASK = 1024;
+
+    // The drivers are templates on the score of a pair, score(set1, set2), so that the score policies are inlined
+    // in the loops, while the std::function overloads pay the indirect call.
+
+    // The upper triangle of the pairs of num_sets sets split into square tiles of side sets, which hold as many sets
+    // of set_bytes as fit in TILE_BYTES.
+    struct Tiles {
+        std::size_t num_sets;
+        std::size_t side;
+        std::vector<std::pair<std::size_t, std::size_t>> tiles;
+    };
+
+    Tiles getTiles(std::size_t num_sets, std::size_t set_bytes) {
+        Tiles result{num_sets, std::clamp(TILE_BYTES / std::max<std::size_t>(1, set_bytes), MIN_TILE_SIDE,
+                                          MAX_TILE_SIDE), {}};
+        std::size_t num_sides = (num_sets + result.side - 1) / result.side;
+        for (auto row = 0u; row < num_sides; row++)
+            for (auto column = row; column < num_sides; column++)
+                result.tiles.emplace_back(row, column);
+        return result;
+    }
+
+    // Calls f(I1, I2) for the pairs I1 < I2 of the tile.
+    template<typename F>
+    void forEachPairInTile(const Tiles &tiles, std::size_t tile, F &&f) {
+        auto [row, column] = tiles.tiles[tile];
+        auto row_end = std::min(tiles.num_sets, (row + 1) * tiles.side);
+        auto column_end = std::min(tiles.num_sets, (column + 1) * tiles.side);
+        for (auto I1 = row * tiles.side; I1 < row_end; I1++)
+            for (auto I2 = std::max(I1 + 1, column * tiles.side); I2 < column_end; I2++)
+                f(I1, I2);
+    }
+
+    /*
+     * Calculates the score for each pair of the selected sets, with score_function(set1, set2) on their indexes.
+     * The tiles are scored in parallel into a buffer per tile.
+     */
+    template<typename T, typename Score>
+    pair_map<T> scoreTiles(const std::vector<int> &selected, std::size_t set_bytes, const Score &score_function,
+                           unsigned num_threads) {
+        if (selected.size() < 2)
+            return {};
+
+        auto tiles = getTiles(selected.size(), set_bytes);
+        std::vector<pair_buffer<T>> buffers(tiles.tiles.size());
+        parallelFor(tiles.tiles.size(), [&](std::size_t task) {
+            forEachPairInTile(tiles, task, [&](std::size_t I1, std::size_t I2) {
+                T score = score_function(selected[I1], selected[I2]);
+                if (isPositive(score))
+                    buffers[task].emplace_back(std::make_pair(selected[I1], selected[I2]), score);
+            });
+        }, num_threads);
+
+        return mergeBuffers(buffers);
     }
+
+    /*
+     * Calculates the score for each pair of sets.
+     * The calculation requires just the sets of vertices. No need for the edges.
+     */
+    template<typename T, typename Score>
+    pair_map<T> scoreAllPairs(const vb &vertex_sets, const Score &score_function,
+                              const int min_module_size, const int max_module_size, unsigned num_threads) {
+
+        // Sizes are counted once
+        std::vector<int> selected;
+        for (auto I = 0u; I < vertex_sets.size(); I++) {
+            long long size = vertex_sets[I].count();
+            if (min_module_size <= size && size <= max_module_size)
+                selected.push_back(I);
+        }
+        if (selected.empty())
+            return {};
+
+        return scoreTiles<T>(selected, vertex_sets[selected[0]].blocks() * sizeof(unsigned), [&](int set1, int set2) {
+            return score_function(vertex_sets[set1], vertex_sets[set2]);
+        }, num_threads);
+    }
+
+    template<typename Score, typename Bound>
+    pair_map<double> scorePairsAbove(const ModuleSetCollection &modules, const Score &score_function,
+                                     const Bound &upper_bound, double threshold,
+                                     const int min_module_size, const int max_module_size, unsigned num_threads) {
+
+        if (max_module_size < 0 || max_module_size < min_module_size)
+            return {};
+        auto candidates = modules.getModulesWithSizes(std::max(0, min_module_size), max_module_size);
+
+        const std::size_t num_tasks = (candidates.size() + MODULES_PER_TASK - 1) / MODULES_PER_TASK;
+        std::vector<pair_buffer<double>> buffers(num_tasks);
+        parallelFor(num_tasks, [&](std::size_t task) {
+            auto last = std::min(candidates.size(), (task + 1) * MODULES_PER_TASK);
+            for (auto I1 = task * MODULES_PER_TASK; I1 < last; I1++) {
+                int module1 = candidates[I1];
+                for (auto I2 = I1 + 1; I2 < candidates.size(); I2++) {
+                    int module2 = candidates[I2];
+                    if (upper_bound(modules.getSize(module1), modules.getSize(module2)) < threshold)
+                        break;
+                    double score = score_function(modules.getSet(module1), modules.getSet(module2));
+                    if (score > 0 && score >= threshold)
+                        buffers[task].emplace_back(std::minmax(module1, module2), score);
+                }
+            }
+        }, num_threads);
+
+        return mergeBuffers(buffers);
+    }
+
+    template<typename Score, typename Bound>
+    std::vector<std::vector<std::pair<int, double>>>
+    scoreTopPairs(const ModuleSetCollection &modules, const Score &score_function, const Bound &upper_bound, int k,
+                  unsigned num_threads) {
+
+        std::vector<std::vector<std::pair<int, double>>> result(modules.size());
+        if (k <= 0)
+            return result;
+
+        auto order = modules.getOrderBySize();
+        std::vector<int> position(modules.size());
+        for (auto I = 0u; I < order.size(); I++)
+            position[order[I]] = I;
+
+        // Higher score first, then lower module index. The heap keeps the worst of the k best at the front.
+        auto isBetter = [](const std::pair<int, double> &a, const std::pair<int, double> &b) {
+            return a.second > b.second || (a.second == b.second && a.first < b.first);
+        };
+
+        parallelFor(modules.size(), [&](std::size_t query) {
+            auto &best = result[query];
+            best.reserve(k);
+            const auto query_size = modules.getSize(query);
+
+            // Expand from the position of the query in the size order towards smaller and larger modules,
+            // taking each time the side with the higher bound
+            long long smaller = static_cast<long long>(position[query]) - 1;
+            std::size_t larger = position[query] + 1;
+            auto boundOf = [&](int module) { return upper_bound(query_size, modules.getSize(module)); };
+            while (smaller >= 0 || larger < order.size()) {
+                double smaller_bound = smaller >= 0 ? boundOf(order[smaller]) : -1;
+                double larger_bound = larger < order.size() ? boundOf(order[larger]) : -1;
+                double bound = std::max(smaller_bound, larger_bound);
+                if (static_cast<int>(best.size()) == k && bound < best.front().second)
+                    break;
+                int candidate = smaller_bound >= larger_bound ? order[smaller--] : order[larger++];
+
+                std::pair<int, double> scored(candidate,
+                                              score_function(modules.getSet(query), modules.getSet(candidate)));
+                if (scored.second <= 0)
+                    continue;
+                if (static_cast<int>(best.size()) < k) {
+                    best.push_back(scored);
+                    std::push_heap(best.begin(), best.end(), isBetter);
+                } else if (isBetter(scored, best.front())) {
+                    std::pop_heap(best.begin(), best.end(), isBetter);
+                    best.back() = scored;
+                    std::push_heap(best.begin(), best.end(), isBetter);
+                }
+            }
+            std::sort_heap(best.begin(), best.end(), isBetter);
+        }, num_threads);
+
+        return result;
+    }
+
+    // Score of a pair of sets with a policy
+    template<typename Policy>
+    struct PolicyScore {
+        typename Policy::value_type operator()(const base::dynamic_bitset<> &set1,
+                                               const base::dynamic_bitset<> &set2) const {
+            return Policy::get(getOverlapCounts(set1, set2));
+        }
+    };
+
+    template<typename Policy>
+    struct PolicyUpperBound {
+        double operator()(std::size_t size1, std::size_t size2) const {
+            return Policy::getUpperBound(size1, size2);
+        }
+    };
+}
+
+pair_map<double> getScores(const vb &vertex_sets,
+                           std::function<double(const base::dynamic_bitset<> &,
+                                                const base::dynamic_bitset<> &)> score_function,
+                           const int min_module_size, const int max_module_size, unsigned num_threads) {
+    return scoreAllPairs<double>(vertex_sets, score_function, min_module_size, max_module_size, num_threads);
 }
 
-double getOverlapSimilarity(base::dynamic_bitset<> set1, base::dynamic_bitset<> set2) {
-    if (set1.count() == 0 || set2.count() == 0) {
-        return 1.0;
-    } else {
-        double intersection_size = (set1 & set2).count();
-        return intersection_size / min(set1.count(), set2.count());
+template<typename Policy>
+pair_map<typename Policy::value_type> getScores(const vb &vertex_sets, const int min_module_size,
+                                                const int max_module_size, unsigned num_threads) {
+    return scoreAllPairs<typename Policy::value_type>(vertex_sets, PolicyScore<Policy>{}, min_module_size,
+                                                      max_module_size, num_threads);
+}
+
+template pair_map<double> getScores<JaccardScore>(const vb &, int, int, unsigned);
+
+template pair_map<double> getScores<OverlapCoefficientScore>(const vb &, int, int, unsigned);
+
+template pair_map<double> getScores<OverlapSizeScore>(const vb &, int, int, unsigned);
+
+template pair_map<OverlapScores> getScores<AllOverlapScores>(const vb &, int, int, unsigned);
+
+/*
+ * The sizes of the rows are counted once, so each pair only needs the size of the intersection. The intersections
+ * of each tile are counted at once by the blocked popcount kernel, over whole cache lines since the rows are padded.
+ */
+template<typename Policy>
+pair_map<typename Policy::value_type> getScores(const BitMatrix &modules, const int min_module_size,
+                                                const int max_module_size, unsigned num_threads) {
+    using T = typename Policy::value_type;
+    std::vector<std::size_t> sizes(modules.getNumRows());
+    std::vector<const BitMatrix::block_type *> selected;
+    std::vector<int> indexes;
+    for (auto I = 0u; I < modules.getNumRows(); I++) {
+        sizes[I] = modules.getRow(I).count();
+        if (min_module_size <= static_cast<long long>(sizes[I]) && static_cast<long long>(sizes[I]) <= max_module_size) {
+            selected.push_back(modules.getRowBlocks(I));
+            indexes.push_back(I);
+        }
     }
+    if (selected.size() < 2)
+        return {};
+
+    const std::size_t stride = modules.getStride();
+    const PopcountKernel kernel = getBestPopcountKernel();
+    auto tiles = getTiles(selected.size(), stride * sizeof(BitMatrix::block_type));
+    std::vector<pair_buffer<T>> buffers(tiles.tiles.size());
+    parallelFor(tiles.tiles.size(), [&](std::size_t task) {
+        auto [row, column] = tiles.tiles[task];
+        auto row_begin = row * tiles.side, column_begin = column * tiles.side;
+        std::span<const BitMatrix::block_type *const> rows_a(selected.data() + row_begin,
+                                                             std::min(selected.size(), row_begin + tiles.side) - row_begin);
+        std::span<const BitMatrix::block_type *const> rows_b(selected.data() + column_begin,
+                                                             std::min(selected.size(), column_begin + tiles.side) - column_begin);
+        std::vector<std::uint32_t> counts(rows_a.size() * rows_b.size());
+        getIntersectionCounts(rows_a, rows_b, stride, counts.data(), kernel);
+
+        forEachPairInTile(tiles, task, [&](std::size_t I1, std::size_t I2) {
+            int set1 = indexes[I1], set2 = indexes[I2];
+            OverlapCounts pair_counts{sizes[set1], sizes[set2],
+                                      counts[(I1 - row_begin) * rows_b.size() + (I2 - column_begin)]};
+            pair_counts.union_size = pair_counts.size1 + pair_counts.size2 - pair_counts.intersection_size;
+            T score = Policy::get(pair_counts);
+            if (isPositive(score))
+                buffers[task].emplace_back(std::make_pair(set1, set2), score);
+        });
+    }, num_threads);
+
+    return mergeBuffers(buffers);
+}
+
+template pair_map<double> getScores<JaccardScore>(const BitMatrix &, int, int, unsigned);
+
+template pair_map<double> getScores<OverlapCoefficientScore>(const BitMatrix &, int, int, unsigned);
+
+template pair_map<double> getScores<OverlapSizeScore>(const BitMatrix &, int, int, unsigned);
+
+template pair_map<OverlapScores> getScores<AllOverlapScores>(const BitMatrix &, int, int, unsigned);
+
+pair_map<double> getScores(const vb &vertex_sets, ScoreType type, const int min_module_size,
+                           const int max_module_size, unsigned num_threads) {
+    return visitScoreType(type, [&](auto policy) {
+        return getScores<decltype(policy)>(vertex_sets, min_module_size, max_module_size, num_threads);
+    });
+}
+
+pair_map<double> getScores(const BitMatrix &modules, ScoreType type, const int min_module_size,
+                           const int max_module_size, unsigned num_threads) {
+    return visitScoreType(type, [&](auto policy) {
+        return getScores<decltype(policy)>(modules, min_module_size, max_module_size, num_threads);
+    });
+}
+
+template<typename Policy>
+TriangularMatrix<typename Policy::value_type> getDenseScores(const vb &vertex_sets, unsigned num_threads) {
+    TriangularMatrix<typename Policy::value_type> result(vertex_sets.size());
+    auto tiles = getTiles(vertex_sets.size(), vertex_sets.empty() ? 0 : vertex_sets[0].blocks() * sizeof(unsigned));
+    parallelFor(tiles.tiles.size(), [&](std::size_t task) {
+        forEachPairInTile(tiles, task, [&](std::size_t I1, std::size_t I2) {
+            result(I1, I2) = Policy::get(getOverlapCounts(vertex_sets[I1], vertex_sets[I2]));
+        });
+    }, num_threads);
+    return result;
 }
 
-double getOverlapSize(base::dynamic_bitset<> set1, base::dynamic_bitset<> set2) {
-    return (set1 & set2).count();
+template TriangularMatrix<double> getDenseScores<JaccardScore>(const vb &, unsigned);
+
+template TriangularMatrix<double> getDenseScores<OverlapCoefficientScore>(const vb &, unsigned);
+
+template TriangularMatrix<double> getDenseScores<OverlapSizeScore>(const vb &, unsigned);
+
+template TriangularMatrix<OverlapScores> getDenseScores<AllOverlapScores>(const vb &, unsigned);
+
+TriangularMatrix<double> getDenseScores(const vb &vertex_sets, ScoreType type, unsigned num_threads) {
+    return visitScoreType(type, [&](auto policy) {
+        return getDenseScores<decltype(policy)>(vertex_sets, num_threads);
+    });
 }
 
 /*
- * Calculates the score for each pair of sets.
- * The calculation requires just the sets of vertices. No need for the edges.
+ * The tiles are scored in waves of at least one tile per thread, then the buffers of the wave are pushed to the
+ * sink in tile order and reused, so the output does not depend on the number of threads.
  */
-pair_map<double> getScores(const vb &vertex_sets,
-                           std::function<double(base::dynamic_bitset<>,
-                                                base::dynamic_bitset<>)> score_function,
-                           const unsigned int min_module_size, const unsigned int max_module_size) {
+void streamScores(const vb &vertex_sets, ScoreSink &sink, const int min_module_size, const int max_module_size,
+                  bool include_all_pairs, std::size_t chunk_size, unsigned num_threads) {
+    std::vector<int> selected;
+    for (auto I = 0u; I < vertex_sets.size(); I++) {
+        long long size = vertex_sets[I].count();
+        if (min_module_size <= size && size <= max_module_size)
+            selected.push_back(I);
+    }
 
-    pair_map<double> result;
-    for (auto I1 = 0u; I1 < vertex_sets.size(); I1++) {
-        if (vertex_sets[I1].count() < min_module_size || vertex_sets[I1].count() > max_module_size) continue;
-        for (auto I2 = I1 + 1; I2 < vertex_sets.size(); I2++) {
-            if (vertex_sets[I2].count() < min_module_size || vertex_sets[I2].count() > max_module_size) continue;
-            std::cerr << I1 << " -- " << I2 << std::endl;
-            auto score = score_function(vertex_sets[I1], vertex_sets[I2]);
-            if (score > 0)
-                result[make_pair(I1, I2)] = score;
+    if (selected.size() >= 2) {
+        auto tiles = getTiles(selected.size(), vertex_sets[selected[0]].blocks() * sizeof(unsigned));
+        const std::size_t tiles_per_wave = std::max<std::size_t>({1, num_threads, chunk_size / (tiles.side * tiles.side)});
+        std::vector<std::vector<ScoredPair>> buffers(std::min(tiles_per_wave, tiles.tiles.size()));
+
+        for (std::size_t first = 0; first < tiles.tiles.size(); first += tiles_per_wave) {
+            const std::size_t num_tiles = std::min(tiles_per_wave, tiles.tiles.size() - first);
+            parallelFor(num_tiles, [&](std::size_t task) {
+                buffers[task].clear();
+                forEachPairInTile(tiles, first + task, [&](std::size_t I1, std::size_t I2) {
+                    int set1 = selected[I1], set2 = selected[I2];
+                    auto scores = AllOverlapScores::get(getOverlapCounts(vertex_sets[set1], vertex_sets[set2]));
+                    if (include_all_pairs || scores.overlap_size > 0)
+                        buffers[task].push_back({set1, set2, scores});
+                });
+            }, num_threads);
+
+            for (std::size_t task = 0; task < num_tiles; task++)
+                if (!buffers[task].empty())
+                    sink.consume(buffers[task]);
         }
     }
+    sink.finish();
+}
 
+/*
+ * Each tile covers the pairs of modules at the three levels, so its sets at all levels are sized to fit in the
+ * cache together. The rows of each tile are buffered, then concatenated and sorted.
+ */
+std::vector<LevelOverlapScores> getLevelOverlapScores(const vb &gene_sets, const vb &protein_sets,
+                                                      const vb &proteoform_sets, unsigned num_threads) {
+    if (gene_sets.size() != protein_sets.size() || gene_sets.size() != proteoform_sets.size())
+        throw std::invalid_argument("Provided module collections with different numbers of modules per level.");
+    if (gene_sets.size() < 2)
+        return {};
+
+    const std::array<const vb *, 3> sets = {&gene_sets, &protein_sets, &proteoform_sets};
+    std::size_t set_bytes = 0;
+    for (const vb *level_sets : sets)
+        set_bytes += level_sets->front().blocks() * sizeof(unsigned);
+    auto tiles = getTiles(gene_sets.size(), set_bytes);
+
+    std::vector<std::vector<LevelOverlapScores>> buffers(tiles.tiles.size());
+    parallelFor(tiles.tiles.size(), [&](std::size_t task) {
+        forEachPairInTile(tiles, task, [&](std::size_t I1, std::size_t I2) {
+            LevelOverlapScores row;
+            bool overlap = false;
+            for (int level = genes; level <= proteoforms; level++) {
+                row.levels[level] = AllOverlapScores::get(getOverlapCounts((*sets[level])[I1], (*sets[level])[I2]));
+                overlap |= row.levels[level].overlap_size > 0;
+            }
+            if (!overlap)
+                return;
+            row.module1 = I1;
+            row.module2 = I2;
+            const auto &gene_scores = row.levels[genes], &proteoform_scores = row.levels[proteoforms];
+            row.overlap_size_delta = static_cast<long long>(proteoform_scores.overlap_size) - gene_scores.overlap_size;
+            row.overlap_similarity_delta = proteoform_scores.overlap_similarity - gene_scores.overlap_similarity;
+            row.jaccard_similarity_delta = proteoform_scores.jaccard_similarity - gene_scores.jaccard_similarity;
+            buffers[task].push_back(row);
+        });
+    }, num_threads);
+
+    std::size_t num_rows = 0;
+    for (const auto &buffer : buffers)
+        num_rows += buffer.size();
+    std::vector<LevelOverlapScores> result;
+    result.reserve(num_rows);
+    for (const auto &buffer : buffers)
+        result.insert(result.end(), buffer.begin(), buffer.end());
+    std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+        return std::tie(a.module1, a.module2) < std::tie(b.module1, b.module2);
+    });
     return result;
 }
 
+void writeLevelOverlapScores(std::ostream &output, const std::vector<LevelOverlapScores> &scores,
+                             const std::vector<std::string> &module_names) {
+    output << "MODULE1\tMODULE2";
+    for (int level = genes; level <= proteoforms; level++) {
+        std::string prefix = LEVELS[level];
+        std::transform(prefix.begin(), prefix.end(), prefix.begin(), ::toupper);
+        output << "\t" << prefix << "_SHARED_ACCESSIONED_ENTITIES\t" << prefix << "_OVERLAP_COEFFICIENT\t" << prefix
+               << "_JACCARD_INDEX";
+    }
+    output << "\tSHARED_ACCESSIONED_ENTITIES_DELTA\tOVERLAP_COEFFICIENT_DELTA\tJACCARD_INDEX_DELTA\n";
+
+    for (const auto &row : scores) {
+        output << module_names.at(row.module1) << "\t" << module_names.at(row.module2);
+        for (const auto &level_scores : row.levels)
+            output << "\t" << level_scores.overlap_size << "\t" << level_scores.overlap_similarity << "\t"
+                   << level_scores.jaccard_similarity;
+        output << "\t" << row.overlap_size_delta << "\t" << row.overlap_similarity_delta << "\t"
+               << row.jaccard_similarity_delta << "\n";
+    }
+}
+
+double getJaccardUpperBound(std::size_t size1, std::size_t size2) {
+    return JaccardScore::getUpperBound(size1, size2);
+}
+
+double getOverlapSimilarityUpperBound(std::size_t size1, std::size_t size2) {
+    return OverlapCoefficientScore::getUpperBound(size1, size2);
+}
+
+double getOverlapSizeUpperBound(std::size_t size1, std::size_t size2) {
+    return OverlapSizeScore::getUpperBound(size1, size2);
+}
+
+pair_map<double> getScores(const ModuleSetCollection &modules,
+                           std::function<double(const base::dynamic_bitset<> &,
+                                                const base::dynamic_bitset<> &)> score_function,
+                           std::function<double(std::size_t, std::size_t)> upper_bound, double threshold,
+                           const int min_module_size, const int max_module_size, unsigned num_threads) {
+    return scorePairsAbove(modules, score_function, upper_bound, threshold, min_module_size, max_module_size,
+                           num_threads);
+}
+
+template<typename Policy>
+pair_map<double> getScores(const ModuleSetCollection &modules, double threshold,
+                           const int min_module_size, const int max_module_size, unsigned num_threads) {
+    return scorePairsAbove(modules, PolicyScore<Policy>{}, PolicyUpperBound<Policy>{}, threshold,
+                           min_module_size, max_module_size, num_threads);
+}
+
+template pair_map<double> getScores<JaccardScore>(const ModuleSetCollection &, double, int, int, unsigned);
+
+template pair_map<double> getScores<OverlapCoefficientScore>(const ModuleSetCollection &, double, int, int, unsigned);
+
+template pair_map<double> getScores<OverlapSizeScore>(const ModuleSetCollection &, double, int, int, unsigned);
+
+pair_map<double> getScores(const ModuleSetCollection &modules, ScoreType type, double threshold,
+                           const int min_module_size, const int max_module_size, unsigned num_threads) {
+    return visitScoreType(type, [&](auto policy) {
+        return getScores<decltype(policy)>(modules, threshold, min_module_size, max_module_size, num_threads);
+    });
+}
+
+std::vector<std::vector<std::pair<int, double>>>
+getTopScores(const ModuleSetCollection &modules,
+             std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> score_function,
+             std::function<double(std::size_t, std::size_t)> upper_bound, int k, unsigned num_threads) {
+    return scoreTopPairs(modules, score_function, upper_bound, k, num_threads);
+}
+
+template<typename Policy>
+std::vector<std::vector<std::pair<int, double>>>
+getTopScores(const ModuleSetCollection &modules, int k, unsigned num_threads) {
+    return scoreTopPairs(modules, PolicyScore<Policy>{}, PolicyUpperBound<Policy>{}, k, num_threads);
+}
+
+template std::vector<std::vector<std::pair<int, double>>>
+getTopScores<JaccardScore>(const ModuleSetCollection &, int, unsigned);
+
+template std::vector<std::vector<std::pair<int, double>>>
+getTopScores<OverlapCoefficientScore>(const ModuleSetCollection &, int, unsigned);
+
+template std::vector<std::vector<std::pair<int, double>>>
+getTopScores<OverlapSizeScore>(const ModuleSetCollection &, int, unsigned);
+
+std::vector<std::vector<std::pair<int, double>>>
+getTopScores(const ModuleSetCollection &modules, ScoreType type, int k, unsigned num_threads) {
+    return visitScoreType(type, [&](auto policy) {
+        return getTopScores<decltype(policy)>(modules, k, num_threads);
+    });
+}
+
 pair_map<double> getScores(const vb &vertex_sets,
-                           std::function<double(base::dynamic_bitset<>,
-                                                base::dynamic_bitset<>)> score_function,
+                           std::function<double(const base::dynamic_bitset<> &,
+                                                const base::dynamic_bitset<> &)> score_function,
                            const pair_map<double> &prev_scores) {
 
     pair_map<double> result;
@@ -157,7 +620,6 @@ pair_map<double> getScores(const vb &vertex_sets,
 //                  << std::endl;
     }
 
-    std::cerr << "Finished calculating scores. " << std::endl;
     return result;
 }
 
@@ -168,62 +630,94 @@ pair_map<double> getScores(const vb &vertex_sets,
 pair_map<double>
 getScores(const vb &vertex_sets,
           const vusi &edges,
-          std::function<double(base::dynamic_bitset<>, base::dynamic_bitset<>, vusi)> score_function,
+          std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &, const vusi &)> score_function,
           const pair_map<double> &overlap_sizes) {
 
     pair_map<double> result;
     for (const auto &pair : overlap_sizes) {
         result[pair.first] = score_function(vertex_sets[pair.first.first], vertex_sets[pair.first.second], edges);
-        std::cerr << "( " << pair.first.first << " , " << pair.first.second << " ) = " << result[pair.first]
-                  << std::endl;
     }
 
     return result;
 }
 
+namespace {
+    template<typename Score>
+    PairList<double> rescorePairs(const PairList<double> &prev_scores, const Score &score_function,
+                                  unsigned num_threads) {
+        std::vector<double> values(prev_scores.size());
+        parallelFor((prev_scores.size() + PAIRS_PER_TASK - 1) / PAIRS_PER_TASK, [&](std::size_t task) {
+            auto last = std::min(prev_scores.size(), (task + 1) * PAIRS_PER_TASK);
+            for (auto I = task * PAIRS_PER_TASK; I < last; I++)
+                values[I] = score_function(prev_scores.getFirst(I), prev_scores.getSecond(I));
+        }, num_threads);
+        return {prev_scores, std::move(values)};
+    }
+
+    // Rescores the pairs with a value other than 0, row by row in parallel. The others stay 0.
+    template<typename Score>
+    TriangularMatrix<double> rescorePairs(const TriangularMatrix<double> &prev_scores, const Score &score_function,
+                                          unsigned num_threads) {
+        TriangularMatrix<double> result(prev_scores.getNumSets());
+        parallelFor(prev_scores.getNumSets(), [&](std::size_t set1) {
+            auto prev_row = prev_scores.getRow(set1);
+            auto row = result.getRow(set1);
+            for (auto I = 0u; I < prev_row.size(); I++)
+                if (prev_row[I] != 0)
+                    row[I] = score_function(set1, set1 + 1 + I);
+        }, num_threads);
+        return result;
+    }
+}
+
+PairList<double> getScores(const vb &vertex_sets,
+                           std::function<double(const base::dynamic_bitset<> &,
+                                                const base::dynamic_bitset<> &)> score_function,
+                           const PairList<double> &prev_scores, unsigned num_threads) {
+    return rescorePairs(prev_scores, [&](int set1, int set2) {
+        return score_function(vertex_sets[set1], vertex_sets[set2]);
+    }, num_threads);
+}
+
+PairList<double> getScores(const vb &vertex_sets, const vusi &edges,
+                           std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &,
+                                                const vusi &)> score_function,
+                           const PairList<double> &prev_scores, unsigned num_threads) {
+    return rescorePairs(prev_scores, [&](int set1, int set2) {
+        return score_function(vertex_sets[set1], vertex_sets[set2], edges);
+    }, num_threads);
+}
+
+TriangularMatrix<double> getScores(const vb &vertex_sets,
+                                   std::function<double(const base::dynamic_bitset<> &,
+                                                        const base::dynamic_bitset<> &)> score_function,
+                                   const TriangularMatrix<double> &prev_scores, unsigned num_threads) {
+    return rescorePairs(prev_scores, [&](int set1, int set2) {
+        return score_function(vertex_sets[set1], vertex_sets[set2]);
+    }, num_threads);
+}
+
+TriangularMatrix<double> getScores(const vb &vertex_sets, const vusi &edges,
+                                   std::function<double(const base::dynamic_bitset<> &,
+                                                        const base::dynamic_bitset<> &,
+                                                        const vusi &)> score_function,
+                                   const TriangularMatrix<double> &prev_scores, unsigned num_threads) {
+    return rescorePairs(prev_scores, [&](int set1, int set2) {
+        return score_function(vertex_sets[set1], vertex_sets[set2], edges);
+    }, num_threads);
+}
+
 /*
  * Calculates the number of nodes in the interface between the two modules
  */
 double calculate_interface_size_nodes(const base::dynamic_bitset<> &V1,
                                       const base::dynamic_bitset<> &V2,
                                       const vusi &E) {
-    std::set<int> interface_nodes;
-    // Count the number of nodes with an edge going to the other set
-    for (int start_node = 0u; start_node < V1.size(); start_node++) {
-        for (int end_node : E[start_node]) {
-            if (V1[start_node] && V2[end_node]) {
-                interface_nodes.insert({start_node, end_node});
-            } else if (V1[start_node] && V2[start_node]) {
-                interface_nodes.insert(start_node);
-            } else if (V1[end_node] && V2[end_node]) {
-                interface_nodes.insert(end_node);
-            }
-        }
-    }
-    return interface_nodes.size();
+    return getInterfaceSizes(V1, V2, E).nodes;
 }
 
 double calculate_interface_size_edges(const base::dynamic_bitset<> &V1,
                                       const base::dynamic_bitset<> &V2,
                                       const vusi &E) {
-    int result = 0;
-
-    for (int start_node = 0u; start_node < V1.size(); start_node++) {
-        if (V1[start_node] || V2[start_node]) {             // Check if the node belongs to any of the two modules
-            for (int end_node : E[start_node]) {
-                if (start_node < end_node) {                // Check all edges only once, not in both directions.
-                    if (V1[start_node] || V2[start_node]) { // Check if the node belongs to any of the two modules
-                        // Check if the nodes are both in the overlap Or if the nodes are in different modules
-                        // Or one node is in the overlap and the other not
-                        if (!((!V1[start_node] && !V1[end_node] && V2[start_node] && V2[end_node]) ||
-                              (V1[start_node] && V1[end_node] && !V2[start_node] && !V2[end_node]))) {
-                            result++;
-                            std::cerr << "( " << start_node << ", " << end_node << ")\n";
-                        }
-                    }
-                }
-            }
-        }
-    }
-    return result;
+    return getInterfaceSizes(V1, V2, E).edges;
 }
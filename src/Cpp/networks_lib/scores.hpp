@@ -12,12 +12,21 @@
 #include <string_view>
 #include "../base/bitset.h"
 #include <bitset>
+#include <functional>
 #include <unordered_map>
 #include <utility>
+#include <array>
 
 #include "types.hpp"
 #include "bimap_str_int.hpp"
 #include "overlap_types.hpp"
+#include "parallel.hpp"
+#include "overlap_counts.hpp"
+#include "score_policies.hpp"
+#include "module_set_collection.hpp"
+#include "bit_matrix.hpp"
+#include "pair_storage.hpp"
+#include "score_sink.hpp"
 
 struct measures_result {
     double min;
@@ -38,27 +47,169 @@ writeMeasures(std::ofstream &report, const measures_result &measures, std::strin
 
 void writeMeasures(std::ofstream &report, const ummss &mapping, std::string_view label1, std::string_view label2);
 
+// Similarity scores of two sets, computed by getOverlapCounts without allocating. See OverlapCounts for definitions.
+double getJaccardSimilarity(const base::dynamic_bitset<> &set1, const base::dynamic_bitset<> &set2);
+
+double getOverlapSimilarity(const base::dynamic_bitset<> &set1, const base::dynamic_bitset<> &set2);
+
+double getOverlapSize(const base::dynamic_bitset<> &set1, const base::dynamic_bitset<> &set2);
+
 // Calculate score between al pairs of bitsets
 // The sets are the second value of each entry in the sets parameter.
 // The score is a function capable of calculating the overlap with bitsets.
 // Returns only the sets within the module sizes and with a score greater than 0.
+// The pairs are scored on num_threads threads, so the score function must be safe to call concurrently.
+pair_map<double>
+getScores(const vb &vertex_sets, std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> score_function,
+          const int min_module_size, const int max_module_size, unsigned num_threads = getNumThreads());
+
+// As above, with a score policy of score_policies.hpp computed from the getOverlapCounts of each pair.
+// Instantiated for JaccardScore, OverlapCoefficientScore, OverlapSizeScore and AllOverlapScores.
+template<typename Policy>
+pair_map<typename Policy::value_type>
+getScores(const vb &vertex_sets, const int min_module_size, const int max_module_size,
+          unsigned num_threads = getNumThreads());
+
+// As above, with the policy chosen at runtime.
 pair_map<double>
-getScores(const vb &vertex_sets, std::function<double(base::dynamic_bitset<>, base::dynamic_bitset<>)> score_function,
-          const int min_module_size, const int max_module_size);
+getScores(const vb &vertex_sets, ScoreType type, const int min_module_size, const int max_module_size,
+          unsigned num_threads = getNumThreads());
+
+// As above, for the rows of a bit matrix. The rows are scored in the same cache sized tiles.
+template<typename Policy>
+pair_map<typename Policy::value_type>
+getScores(const BitMatrix &modules, const int min_module_size, const int max_module_size,
+          unsigned num_threads = getNumThreads());
+
+pair_map<double>
+getScores(const BitMatrix &modules, ScoreType type, const int min_module_size, const int max_module_size,
+          unsigned num_threads = getNumThreads());
+
+// Score of every pair of sets, including those with score 0, in a dense matrix. For full all pairs runs, where
+// most pairs have a score, this avoids the hash map. Scored in the same tiles as getScores.
+template<typename Policy>
+TriangularMatrix<typename Policy::value_type>
+getDenseScores(const vb &vertex_sets, unsigned num_threads = getNumThreads());
+
+TriangularMatrix<double> getDenseScores(const vb &vertex_sets, ScoreType type, unsigned num_threads = getNumThreads());
+
+// Scores every pair of sets within the module sizes like getScores, but pushes the overlap scores to the sink in
+// chunks instead of returning them, so the memory used is bounded by the chunk size and not by the number of pairs.
+// Keeps the pairs that share entities, or all of them with include_all_pairs, like overlapping_pairs.tsv and
+// all_pairs.tsv of calculateOverlap. About chunk_size pairs are scored in parallel before each push, and at least
+// one tile per thread. The pairs arrive in the same order for any number of threads.
+void streamScores(const vb &vertex_sets, ScoreSink &sink, const int min_module_size, const int max_module_size,
+                  bool include_all_pairs = false, std::size_t chunk_size = 1 << 20,
+                  unsigned num_threads = getNumThreads());
+
+// Overlap of a pair of modules at the gene, protein and proteoform levels, indexed by Level, and its change from the
+// gene level to the proteoform level.
+struct LevelOverlapScores {
+    int module1 = 0;
+    int module2 = 0;
+    std::array<OverlapScores, 3> levels;
+    long long overlap_size_delta = 0;           // Proteoform level minus gene level
+    double overlap_similarity_delta = 0.0;
+    double jaccard_similarity_delta = 0.0;
+
+    bool operator==(const LevelOverlapScores &other) const = default;
+};
+
+// Scores every pair of modules at the three levels in a single parallel sweep. The three collections have the
+// modules of the same traits in the same order, each over the entities of its level. Returns one row per pair of
+// modules sharing entities at any level, sorted by pair.
+std::vector<LevelOverlapScores> getLevelOverlapScores(const vb &gene_sets, const vb &protein_sets,
+                                                      const vb &proteoform_sets,
+                                                      unsigned num_threads = getNumThreads());
+
+// Writes the rows as a table with a header, with the module names at the indexes of the collections.
+void writeLevelOverlapScores(std::ostream &output, const std::vector<LevelOverlapScores> &scores,
+                             const std::vector<std::string> &module_names);
+
+// Upper bounds of the similarity scores given only the sizes of the two sets. They do not increase with the size of
+// the larger set, which is what the pruned getScores needs.
+double getJaccardUpperBound(std::size_t size1, std::size_t size2);
+
+double getOverlapSimilarityUpperBound(std::size_t size1, std::size_t size2);
+
+double getOverlapSizeUpperBound(std::size_t size1, std::size_t size2);
+
+// Calculate score between all pairs of modules within the module sizes.
+// Returns only the pairs with a score greater than 0 and at least the threshold.
+// Each module is compared with the larger modules in size order, until the upper bound of the score given the
+// sizes falls below the threshold, so the upper bound must not increase with the size of the larger set.
+pair_map<double>
+getScores(const ModuleSetCollection &modules,
+          std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> score_function,
+          std::function<double(std::size_t, std::size_t)> upper_bound, double threshold,
+          const int min_module_size, const int max_module_size, unsigned num_threads = getNumThreads());
+
+// As above, with the score and its upper bound from a scalar score policy, or from the policy of the score type.
+template<typename Policy>
+pair_map<double>
+getScores(const ModuleSetCollection &modules, double threshold, const int min_module_size, const int max_module_size,
+          unsigned num_threads = getNumThreads());
+
+pair_map<double>
+getScores(const ModuleSetCollection &modules, ScoreType type, double threshold,
+          const int min_module_size, const int max_module_size, unsigned num_threads = getNumThreads());
+
+// Finds the k modules with the highest scores with each module, without scoring all the pairs.
+// Returns for each module the other modules with a score greater than 0, as (module, score) pairs by decreasing
+// score, ties by module index. Each module is compared with the others in order of increasing size difference,
+// until the upper bound of the score given the sizes falls below its k-th best score. The upper bound must not
+// increase as the two sizes move apart, like the bounds above. The modules are queried in parallel.
+std::vector<std::vector<std::pair<int, double>>>
+getTopScores(const ModuleSetCollection &modules,
+             std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> score_function,
+             std::function<double(std::size_t, std::size_t)> upper_bound, int k,
+             unsigned num_threads = getNumThreads());
+
+template<typename Policy>
+std::vector<std::vector<std::pair<int, double>>>
+getTopScores(const ModuleSetCollection &modules, int k, unsigned num_threads = getNumThreads());
+
+std::vector<std::vector<std::pair<int, double>>>
+getTopScores(const ModuleSetCollection &modules, ScoreType type, int k, unsigned num_threads = getNumThreads());
 
 // Calculate score between the selected pairs.
 // The sets are the second value of each entry in the sets parameter.
 // The score is a function capable of calculating the overlap with bitsets.
 pair_map<double>
-getScores(const vb &vertex_sets, std::function<double(base::dynamic_bitset<>, base::dynamic_bitset<>)> score_function,
+getScores(const vb &vertex_sets, std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> score_function,
           const pair_map<double> &prev_score);
 
 pair_map<double>
 getScores(const vb &vertex_sets,
           const vusi &edges,
-          std::function<double(base::dynamic_bitset<>, base::dynamic_bitset<>, vusi)> score_function,
+          std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &, const vusi &)> score_function,
           const pair_map<double> &prev_score);
 
+// As above, rescoring the pairs of a sorted pair list or of a dense matrix in parallel, so the score function must
+// be safe to call concurrently. The result keeps the pairs of prev_scores; for the matrix, the pairs with value 0
+// are not rescored and stay 0.
+PairList<double>
+getScores(const vb &vertex_sets, std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> score_function,
+          const PairList<double> &prev_scores, unsigned num_threads = getNumThreads());
+
+PairList<double>
+getScores(const vb &vertex_sets,
+          const vusi &edges,
+          std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &, const vusi &)> score_function,
+          const PairList<double> &prev_scores, unsigned num_threads = getNumThreads());
+
+TriangularMatrix<double>
+getScores(const vb &vertex_sets, std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &)> score_function,
+          const TriangularMatrix<double> &prev_scores, unsigned num_threads = getNumThreads());
+
+TriangularMatrix<double>
+getScores(const vb &vertex_sets,
+          const vusi &edges,
+          std::function<double(const base::dynamic_bitset<> &, const base::dynamic_bitset<> &, const vusi &)> score_function,
+          const TriangularMatrix<double> &prev_scores, unsigned num_threads = getNumThreads());
+
+// Interface sizes of two modules, as defined in interface_sizes.hpp. The adjacency list must be symmetric.
+// To score many pairs, getInterfaceSizes computes both sizes at once over a CSR adjacency, in parallel.
 double calculate_interface_size_nodes(const base::dynamic_bitset<> &V1,
                                       const base::dynamic_bitset<> &V2,
                                       const vusi &E);
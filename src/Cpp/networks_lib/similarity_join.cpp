@@ -0,0 +1,174 @@
+#include "similarity_join.hpp"
+#include "pair_buffers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    constexpr std::size_t SETS_PER_TASK = 64;
+    constexpr int PRUNED = -1;
+
+    // Rounds up, tolerating the rounding error of the products with the threshold
+    int roundUp(double value) {
+        return static_cast<int>(std::ceil(value - 1e-9));
+    }
+
+    struct Posting {
+        int set;        // Position of the set in the size order
+        int position;   // Position of the entity in the set
+    };
+
+    // Minimum overlap for the pair to reach the threshold, where size1 <= size2. At least 1, since only pairs
+    // sharing entities are found through the index.
+    int getMinOverlap(ScoreType type, double threshold, int size1, int size2) {
+        switch (type) {
+            case ScoreType::jaccard:
+                return std::max(1, roundUp(threshold / (1 + threshold) * (size1 + size2)));
+            case ScoreType::overlap_coefficient:
+                return std::max(1, roundUp(threshold * size1));
+            default:
+                return std::max(1, roundUp(threshold));
+        }
+    }
+
+    // Lengths of the prefixes that must contain a shared entity, when size is the smaller size of the pair
+    // (indexed prefix) or the larger one (probing prefix).
+    int getIndexPrefix(ScoreType type, double threshold, int size) {
+        int min_overlap = type == ScoreType::jaccard
+                          ? std::max(1, roundUp(2 * threshold / (1 + threshold) * size))
+                          : getMinOverlap(type, threshold, size, size);
+        return std::max(0, size - min_overlap + 1);
+    }
+
+    int getProbePrefix(ScoreType type, double threshold, int size) {
+        switch (type) {
+            case ScoreType::jaccard:
+                return std::max(0, size - std::max(1, roundUp(threshold * size)) + 1);
+            case ScoreType::overlap_coefficient:
+                return size;    // The smaller set may need a single shared entity
+            default:
+                return std::max(0, size - getMinOverlap(type, threshold, size, size) + 1);
+        }
+    }
+
+    // Smallest size of a set that can reach the threshold with a set of the given larger size
+    int getMinSize(ScoreType type, double threshold, int size) {
+        switch (type) {
+            case ScoreType::jaccard:
+                return roundUp(threshold * size);
+            case ScoreType::overlap_coefficient:
+                return 1;
+            default:
+                return roundUp(threshold);
+        }
+    }
+}
+
+pair_map<double> getSimilarityJoin(const vb &vertex_sets, ScoreType type, double threshold, unsigned num_threads) {
+    if (vertex_sets.empty())
+        return {};
+    const std::size_t num_entities = vertex_sets.front().size();
+    for (const auto &set : vertex_sets)
+        if (set.size() != num_entities)
+            throw std::invalid_argument("Provided sets over different numbers of entities.");
+
+    // Entities ranked from the rarest to the most frequent
+    std::vector<int> frequencies(num_entities, 0);
+    for (const auto &set : vertex_sets)
+        set.visit_set([&](auto entity) { frequencies[entity]++; });
+    std::vector<int> entities(num_entities), ranks(num_entities);
+    std::iota(entities.begin(), entities.end(), 0);
+    std::stable_sort(entities.begin(), entities.end(), [&](int a, int b) { return frequencies[a] < frequencies[b]; });
+    for (auto I = 0u; I < num_entities; I++)
+        ranks[entities[I]] = I;
+
+    // Sets by increasing size, each as its sorted entity ranks
+    std::vector<int> sizes(vertex_sets.size()), order(vertex_sets.size()), empty_sets;
+    for (auto I = 0u; I < vertex_sets.size(); I++)
+        sizes[I] = vertex_sets[I].count();
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return sizes[a] < sizes[b]; });
+    std::vector<std::vector<int>> tokens(order.size());
+    for (auto I = 0u; I < order.size(); I++) {
+        vertex_sets[order[I]].visit_set([&](auto entity) { tokens[I].push_back(ranks[entity]); });
+        std::sort(tokens[I].begin(), tokens[I].end());
+        if (tokens[I].empty())
+            empty_sets.push_back(order[I]);
+    }
+
+    // Prefix index, with the postings of each entity by increasing set size
+    std::vector<std::vector<Posting>> index(num_entities);
+    for (auto I = 0u; I < order.size(); I++) {
+        int prefix = getIndexPrefix(type, threshold, tokens[I].size());
+        for (int J = 0; J < prefix; J++)
+            index[tokens[I][J]].push_back({static_cast<int>(I), J});
+    }
+
+    const std::size_t num_tasks = (order.size() + SETS_PER_TASK - 1) / SETS_PER_TASK;
+    std::vector<pair_buffer<double>> buffers(num_tasks);
+    parallelFor(num_tasks, [&](std::size_t task) {
+        std::vector<int> overlaps(order.size(), 0);
+        std::vector<int> candidates;
+        auto last = std::min(order.size(), (task + 1) * SETS_PER_TASK);
+        for (auto I = task * SETS_PER_TASK; I < last; I++) {
+            const auto &x = tokens[I];
+            const int size_x = x.size();
+            const int min_size = getMinSize(type, threshold, size_x);
+            const int prefix = getProbePrefix(type, threshold, size_x);
+
+            for (int position_x = 0; position_x < prefix; position_x++) {
+                const auto &postings = index[x[position_x]];
+                // Only the smaller sets, earlier in the size order, that are large enough
+                auto first = std::partition_point(postings.begin(), postings.end(), [&](const Posting &posting) {
+                    return static_cast<int>(tokens[posting.set].size()) < min_size;
+                });
+                for (auto it = first; it != postings.end() && it->set < static_cast<int>(I); it++) {
+                    int &overlap = overlaps[it->set];
+                    if (overlap == PRUNED)
+                        continue;
+                    const int size_y = tokens[it->set].size();
+                    int bound = overlap + 1 + std::min(size_x - position_x - 1, size_y - it->position - 1);
+                    if (bound < getMinOverlap(type, threshold, size_y, size_x)) {
+                        if (overlap == 0)
+                            candidates.push_back(it->set);
+                        overlap = PRUNED;
+                    } else {
+                        if (overlap == 0)
+                            candidates.push_back(it->set);
+                        overlap++;
+                    }
+                }
+            }
+
+            for (int candidate : candidates) {
+                if (overlaps[candidate] != PRUNED) {
+                    int set1 = std::min(order[I], order[candidate]), set2 = std::max(order[I], order[candidate]);
+                    auto score = getOverlapCounts(vertex_sets[set1], vertex_sets[set2]).getScore(type);
+                    if (score > 0 && score >= threshold)
+                        buffers[task].emplace_back(std::make_pair(set1, set2), score);
+                }
+                overlaps[candidate] = 0;
+            }
+            candidates.clear();
+        }
+    }, num_threads);
+
+    auto result = mergeBuffers(buffers);
+
+    // Pairs with an empty set share no entity, but some scores are positive for them
+    for (int empty_set : empty_sets) {
+        for (auto other = 0u; other < vertex_sets.size(); other++) {
+            if (static_cast<int>(other) == empty_set || (sizes[other] == 0 && static_cast<int>(other) < empty_set))
+                continue;
+            int set1 = std::min(empty_set, static_cast<int>(other)), set2 = std::max(empty_set, static_cast<int>(other));
+            OverlapCounts counts{static_cast<std::size_t>(sizes[set1]), static_cast<std::size_t>(sizes[set2]), 0,
+                                 static_cast<std::size_t>(sizes[set1] + sizes[set2])};
+            auto score = counts.getScore(type);
+            if (score > 0 && score >= threshold)
+                result[{set1, set2}] = score;
+        }
+    }
+    return result;
+}
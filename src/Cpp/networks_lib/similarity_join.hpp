@@ -0,0 +1,17 @@
+#ifndef PROTEOFORMNETWORKS_SIMILARITY_JOIN_HPP
+#define PROTEOFORMNETWORKS_SIMILARITY_JOIN_HPP
+
+#include "types.hpp"
+#include "overlap_types.hpp"
+#include "overlap_counts.hpp"
+#include "parallel.hpp"
+
+// Finds all pairs of sets with a score of at least threshold, and greater than 0, with prefix filtering in the
+// style of the AllPairs and PPJoin algorithms. The entities are ordered from rare to frequent, and each set is
+// indexed only by the prefix of its rarest entities that any set reaching the threshold must share with it.
+// The candidates found through the prefixes are pruned by their sizes and by the positions of the shared entities,
+// then verified with getOverlapCounts. Returns the same pairs as filtering getScores by the threshold.
+pair_map<double> getSimilarityJoin(const vb &vertex_sets, ScoreType type, double threshold,
+                                   unsigned num_threads = getNumThreads());
+
+#endif //PROTEOFORMNETWORKS_SIMILARITY_JOIN_HPP
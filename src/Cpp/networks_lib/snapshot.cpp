@@ -0,0 +1,70 @@
+#include "snapshot.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace snapshot {
+
+    Writer::Writer(std::string_view path) : path(path), temporary_path(std::string(path) + ".tmp"),
+                                            file(temporary_path, std::ios::binary | std::ios::trunc),
+                                            header{}, position(sizeof(Header)) {
+        if (!file.is_open()) {
+            std::string message = "Cannot open snapshot file ";
+            message += temporary_path;
+            message += " at ";
+            message += __FUNCTION__;
+            throw std::runtime_error(message);
+        }
+        std::copy(std::begin(MAGIC), std::end(MAGIC), header.magic);
+        header.version = VERSION;
+        header.byte_order = BYTE_ORDER_MARK;
+        header.num_sections = NUM_SECTIONS;
+        file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    }
+
+    void Writer::writeBytes(Section section, const char *bytes, std::uint64_t size) {
+        static const char padding[SECTION_ALIGNMENT] = {};
+        auto aligned = (position + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+        file.write(padding, aligned - position);
+        file.write(bytes, size);
+        header.sections[section] = {aligned, size};
+        position = aligned + size;
+    }
+
+    void Writer::close() {
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+        file.flush();
+        file.close();
+        if (file.fail()) {
+            std::filesystem::remove(temporary_path);
+            throw std::runtime_error("Failed writing snapshot file " + temporary_path);
+        }
+        std::filesystem::rename(temporary_path, path);
+    }
+
+    Reader::Reader(std::string_view path) : mapping(std::make_shared<const MappedFile>(path)) {
+        std::string file_name(path);
+        if (mapping->size() < sizeof(Header))
+            throw std::runtime_error("Snapshot file is too short: " + file_name);
+        header = reinterpret_cast<const Header *>(mapping->data());
+        if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0)
+            throw std::runtime_error("File is not a snapshot: " + file_name);
+        if (header->byte_order != BYTE_ORDER_MARK)
+            throw std::runtime_error("Snapshot was written with a different byte order: " + file_name);
+        if (header->version != VERSION || header->num_sections != NUM_SECTIONS)
+            throw std::runtime_error("Snapshot version " + std::to_string(header->version) + " is not supported, "
+                                     + "expected version " + std::to_string(VERSION) + ": " + file_name);
+    }
+
+    const char *Reader::sectionBytes(Section section, std::size_t element_size, std::size_t element_alignment,
+                                     std::size_t &count) const {
+        const auto &entry = header->sections[section];
+        if (entry.offset > mapping->size() || entry.size > mapping->size() - entry.offset)
+            throw std::runtime_error("Snapshot section " + std::to_string(section) + " is out of the file bounds.");
+        if (entry.offset % element_alignment != 0 || entry.size % element_size != 0)
+            throw std::runtime_error("Snapshot section " + std::to_string(section) + " is misaligned.");
+        count = entry.size / element_size;
+        return mapping->data() + entry.offset;
+    }
+}
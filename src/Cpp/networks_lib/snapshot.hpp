@@ -0,0 +1,89 @@
+#ifndef PROTEOFORMNETWORKS_SNAPSHOT_HPP
+#define PROTEOFORMNETWORKS_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "frozen_array.hpp"
+#include "mapped_file.hpp"
+
+// Binary snapshot files: a fixed header followed by the raw arrays of the data structure.
+// Each array (section) starts at a cache line aligned offset, so it can be used in place after mapping the file.
+// Snapshots are only readable by the same format version and byte order that wrote them.
+namespace snapshot {
+
+    constexpr char MAGIC[8] = {'P', 'F', 'N', 'S', 'N', 'A', 'P', '\0'};
+    constexpr std::uint32_t VERSION = 4;
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr std::uint64_t SECTION_ALIGNMENT = 64;
+
+    enum Section : std::uint32_t {
+        IS_NODE, OFFSETS, NEIGHBORS, NAME_OFFSETS, NAME_CHARS, NAME_SLOTS, LEVEL_STARTS, LEVEL_ENDS, LEVEL_SPLITS,
+        GENE_PROTEIN_OFFSETS, GENE_PROTEIN_TARGETS, PROTEIN_GENE_OFFSETS, PROTEIN_GENE_TARGETS,
+        PROTEIN_PROTEOFORM_OFFSETS, PROTEIN_PROTEOFORM_TARGETS, PROTEOFORM_PROTEIN_OFFSETS, PROTEOFORM_PROTEIN_TARGETS,
+        NUM_SECTIONS
+    };
+
+    struct SectionEntry {
+        std::uint64_t offset;
+        std::uint64_t size;     // In bytes
+    };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint64_t num_sections;
+        SectionEntry sections[NUM_SECTIONS];
+    };
+
+    // Writes the snapshot to path + ".tmp" and renames it over path on close, so a reader that maps path during
+    // a rewrite sees either the old snapshot or the complete new one.
+    class Writer {
+        std::string path;
+        std::string temporary_path;
+        std::ofstream file;
+        Header header;
+        std::uint64_t position;
+
+        void writeBytes(Section section, const char *bytes, std::uint64_t size);
+
+    public:
+
+        explicit Writer(std::string_view path);
+
+        template<typename T>
+        void write(Section section, std::span<const T> values) {
+            writeBytes(section, reinterpret_cast<const char *>(values.data()), values.size_bytes());
+        }
+
+        // Writes the header and replaces the file at path. The snapshot is not valid until this is called.
+        void close();
+    };
+
+    class Reader {
+        std::shared_ptr<const MappedFile> mapping;
+        const Header *header;
+
+        [[nodiscard]] const char *sectionBytes(Section section, std::size_t element_size,
+                                               std::size_t element_alignment, std::size_t &count) const;
+
+    public:
+
+        explicit Reader(std::string_view path);
+
+        // Returns a view of the section inside the mapped file.
+        template<typename T>
+        [[nodiscard]] FrozenArray<T> read(Section section) const {
+            std::size_t count;
+            auto bytes = sectionBytes(section, sizeof(T), alignof(T), count);
+            return FrozenArray<T>(mapping, std::span<const T>(reinterpret_cast<const T *>(bytes), count));
+        }
+    };
+}
+
+#endif //PROTEOFORMNETWORKS_SNAPSHOT_HPP
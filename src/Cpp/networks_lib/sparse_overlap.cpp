@@ -0,0 +1,87 @@
+#include "sparse_overlap.hpp"
+#include "pair_buffers.hpp"
+
+#include <stdexcept>
+
+namespace {
+    constexpr std::size_t SETS_PER_TASK = 64;
+}
+
+PostingLists::PostingLists(const vb &vertex_sets, std::span<const int> selected) {
+    const std::size_t num_entities = selected.empty() ? 0 : vertex_sets[selected.front()].size();
+    offsets.assign(num_entities + 1, 0);
+    for (int set : selected) {
+        if (vertex_sets[set].size() != num_entities)
+            throw std::invalid_argument("Provided sets over different numbers of entities.");
+        vertex_sets[set].visit_set([&](auto entity) { offsets[entity + 1]++; });
+    }
+    for (std::size_t I = 0; I < num_entities; I++)
+        offsets[I + 1] += offsets[I];
+
+    // Filled in order of the selected sets, so each list is sorted if they are
+    sets.resize(offsets.back());
+    std::vector<int> positions(offsets.begin(), offsets.end() - 1);
+    for (int set : selected)
+        vertex_sets[set].visit_set([&](auto entity) { sets[positions[entity]++] = set; });
+}
+
+pair_map<double> getSparseScores(const vb &vertex_sets, std::function<double(const OverlapCounts &)> score_function,
+                                 const int min_module_size, const int max_module_size, unsigned num_threads) {
+    std::vector<int> selected, empty_sets;
+    std::vector<std::size_t> sizes(vertex_sets.size());
+    for (auto I = 0u; I < vertex_sets.size(); I++) {
+        sizes[I] = vertex_sets[I].count();
+        if (min_module_size <= static_cast<long long>(sizes[I]) && static_cast<long long>(sizes[I]) <= max_module_size) {
+            selected.push_back(I);
+            if (sizes[I] == 0)
+                empty_sets.push_back(I);
+        }
+    }
+    PostingLists posting_lists(vertex_sets, selected);
+
+    auto countsOf = [&](int set1, int set2, std::size_t intersection_size) {
+        return OverlapCounts{sizes[set1], sizes[set2], intersection_size,
+                             sizes[set1] + sizes[set2] - intersection_size};
+    };
+
+    // Each task accumulates the intersections of its sets with the later sets in a dense counter array,
+    // remembering which counters it touched to reset them
+    const std::size_t num_tasks = (selected.size() + SETS_PER_TASK - 1) / SETS_PER_TASK;
+    std::vector<pair_buffer<double>> buffers(num_tasks);
+    parallelFor(num_tasks, [&](std::size_t task) {
+        std::vector<int> intersection_sizes(vertex_sets.size(), 0);
+        std::vector<int> touched;
+        auto last = std::min(selected.size(), (task + 1) * SETS_PER_TASK);
+        for (auto I = task * SETS_PER_TASK; I < last; I++) {
+            int set1 = selected[I];
+            vertex_sets[set1].visit_set([&](auto entity) {
+                auto postings = posting_lists.get(entity);
+                for (auto it = std::upper_bound(postings.begin(), postings.end(), set1); it != postings.end(); it++)
+                    if (intersection_sizes[*it]++ == 0)
+                        touched.push_back(*it);
+            });
+            for (int set2 : touched) {
+                auto score = score_function(countsOf(set1, set2, intersection_sizes[set2]));
+                if (score > 0)
+                    buffers[task].emplace_back(std::make_pair(set1, set2), score);
+                intersection_sizes[set2] = 0;
+            }
+            touched.clear();
+        }
+    }, num_threads);
+
+    auto result = mergeBuffers(buffers);
+
+    // Pairs with an empty set share no entity, but some scores are positive for them
+    for (int empty_set : empty_sets) {
+        for (int other : selected) {
+            if (other == empty_set || (sizes[other] == 0 && other < empty_set))
+                continue;
+            auto [set1, set2] = std::minmax(empty_set, other);
+            auto score = score_function(countsOf(set1, set2, 0));
+            if (score > 0)
+                result[{set1, set2}] = score;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,40 @@
+#ifndef PROTEOFORMNETWORKS_SPARSE_OVERLAP_HPP
+#define PROTEOFORMNETWORKS_SPARSE_OVERLAP_HPP
+
+#include <functional>
+#include <span>
+#include <vector>
+#include "types.hpp"
+#include "overlap_types.hpp"
+#include "overlap_counts.hpp"
+#include "parallel.hpp"
+
+// Inverted index of a group of vertex sets: for each entity, the sorted indexes of the sets that contain it.
+// The posting lists are stored in CSR form, like the Interactome adjacency.
+class PostingLists {
+    std::vector<int> offsets;       // Size is number of entities + 1
+    std::vector<int> sets;
+
+public:
+
+    PostingLists() = default;
+
+    // Indexes only the selected sets, which must have the same number of entities.
+    PostingLists(const vb &vertex_sets, std::span<const int> selected);
+
+    [[nodiscard]] int getNumEntities() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    [[nodiscard]] std::span<const int> get(int entity) const {
+        return {sets.data() + offsets[entity], static_cast<std::size_t>(offsets[entity + 1] - offsets[entity])};
+    }
+};
+
+// Calculate score between all pairs of sets within the module sizes, like getScores, but only for the pairs that
+// share at least one entity, plus the pairs with an empty set. The intersection sizes are accumulated through
+// the posting lists, a sparse product of the set membership matrix with its transpose, so the pairs without
+// common entities cost nothing. Returns only the pairs with a score greater than 0.
+pair_map<double> getSparseScores(const vb &vertex_sets, std::function<double(const OverlapCounts &)> score_function,
+                                 const int min_module_size, const int max_module_size,
+                                 unsigned num_threads = getNumThreads());
+
+#endif //PROTEOFORMNETWORKS_SPARSE_OVERLAP_HPP
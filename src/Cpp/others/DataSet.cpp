@@ -282,4 +282,36 @@ void dataset::checkMappingConsistency() {
    }
 }
 
+memory::MemoryReport dataset::getMemoryReport() const {
+   auto bimapBytes = [](const bimap_str_int& bimap) {
+      return memory::heapBytes(bimap.int_to_str) + memory::heapBytes(bimap.str_to_int);
+   };
+   memory::MemoryReport report("dataset");
+   report.add("name", memory::heapBytes(name));
+   report.add("pathways_to_names", memory::heapBytes(pathways_to_names));
+   report.add("phegeni_genes", bimapBytes(phegeni_genes));
+   report.add("proteins", bimapBytes(proteins));
+   report.add("proteoforms", bimapBytes(proteoforms));
+   report.add("modified_proteins", memory::heapBytes(modified_proteins));
+   report.add("modified_proteoforms", memory::heapBytes(modified_proteoforms));
+   report.add("pathways_to_genes", memory::heapBytes(pathways_to_genes));
+   report.add("genes_to_pathways", memory::heapBytes(genes_to_pathways));
+   report.add("reactions_to_genes", memory::heapBytes(reactions_to_genes));
+   report.add("genes_to_reactions", memory::heapBytes(genes_to_reactions));
+   report.add("pathways_to_proteins", memory::heapBytes(pathways_to_proteins));
+   report.add("proteins_to_pathways", memory::heapBytes(proteins_to_pathways));
+   report.add("reactions_to_proteins", memory::heapBytes(reactions_to_proteins));
+   report.add("proteins_to_reactions", memory::heapBytes(proteins_to_reactions));
+   report.add("pathways_to_proteoforms", memory::heapBytes(pathways_to_proteoforms));
+   report.add("proteoforms_to_pathways", memory::heapBytes(proteoforms_to_pathways));
+   report.add("reactions_to_proteoforms", memory::heapBytes(reactions_to_proteoforms));
+   report.add("proteoforms_to_reactions", memory::heapBytes(proteoforms_to_reactions));
+   report.add("gene_network", memory::heapBytes(gene_network));
+   report.add("protein_network", memory::heapBytes(protein_network));
+   report.add("proteoform_network", memory::heapBytes(proteoform_network));
+   report.add("genes_to_proteins", memory::heapBytes(genes_to_proteins));
+   report.add("proteins_to_proteoforms", memory::heapBytes(proteins_to_proteoforms));
+   return report;
+}
+
 }  // namespace pathway
@@ -16,6 +16,7 @@
 #include "proteoform.hpp"
 #include "bimap_str_int.hpp"
 #include "reactome.hpp"
+#include "memory_usage.hpp"
 
 namespace pathway {
 
@@ -60,6 +61,8 @@ class dataset {
    const ummss& getProteinNetwork() const;
    const ummss& getProteoformNetwork() const;
 
+   memory::MemoryReport getMemoryReport() const;
+
   private:
    std::string name;
    umss pathways_to_names;